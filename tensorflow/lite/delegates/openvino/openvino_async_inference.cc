@@ -0,0 +1,48 @@
+// Copyright (C) 2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#include "openvino_async_inference.h"
+
+namespace tflite {
+namespace openvinodelegate {
+
+void OpenVINOAsyncInference::Begin() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  in_flight_++;
+}
+
+void OpenVINOAsyncInference::End(TfLiteStatus status) {
+  Callback callback;
+  void *user_data;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (status != kTfLiteOk) failed_ = true;
+    callback = callback_;
+    user_data = user_data_;
+  }
+  // Called before waiters are released, so that Wait returning means the
+  // application has been notified too.
+  if (callback != nullptr) callback(user_data, status);
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    in_flight_--;
+  }
+  completed_.notify_all();
+}
+
+TfLiteStatus OpenVINOAsyncInference::Wait(std::chrono::milliseconds timeout) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  auto done = [this] { return in_flight_ == 0; };
+  if (timeout.count() < 0) {
+    completed_.wait(lock, done);
+  } else if (!completed_.wait_for(lock, timeout, done)) {
+    return kTfLiteError;
+  }
+  const bool failed = failed_;
+  failed_ = false;
+  return failed ? kTfLiteError : kTfLiteOk;
+}
+
+}  // namespace openvinodelegate
+}  // namespace tflite
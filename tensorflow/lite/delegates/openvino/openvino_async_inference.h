@@ -0,0 +1,62 @@
+// Copyright (C) 2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef TENSORFLOW_LITE_DELEGATES_OPENVINO_ASYNC_INFERENCE_H_
+#define TENSORFLOW_LITE_DELEGATES_OPENVINO_ASYNC_INFERENCE_H_
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+
+#include "tensorflow/lite/c/common.h"
+
+namespace tflite {
+namespace openvinodelegate {
+
+// Inferences of one delegate still running after the Invoke that started
+// them returned. Kernels call Begin before starting an infer request and End
+// from its completion callback, which reports to the application callback.
+class OpenVINOAsyncInference {
+ public:
+  using Callback = void (*)(void *user_data, TfLiteStatus status);
+
+  // callback is called from an OpenVINO thread after each inference, it must
+  // not invoke the interpreter.
+  void SetCallback(Callback callback, void *user_data) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    callback_ = callback;
+    user_data_ = user_data;
+  }
+
+  // Kernels only return from Invoke before the inference completed while a
+  // callback is set.
+  bool hasCallback() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return callback_ != nullptr;
+  }
+
+  void Begin();
+  void End(TfLiteStatus status);
+
+  // Waits up to timeout for the running inferences, forever for a negative
+  // timeout. Fails on timeout or if one of the inferences that completed
+  // since the last Wait failed.
+  TfLiteStatus Wait(std::chrono::milliseconds timeout);
+
+  size_t getInFlight() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return in_flight_;
+  }
+
+ private:
+  std::mutex mutex_;
+  std::condition_variable completed_;
+  size_t in_flight_ = 0;
+  bool failed_ = false;
+  Callback callback_ = nullptr;
+  void *user_data_ = nullptr;
+};
+
+}  // namespace openvinodelegate
+}  // namespace tflite
+#endif  // TENSORFLOW_LITE_DELEGATES_OPENVINO_ASYNC_INFERENCE_H_
@@ -0,0 +1,59 @@
+// Copyright (C) 2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#include "openvino_async_inference.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+namespace tflite {
+namespace openvinodelegate {
+
+TEST(OpenVINOAsyncInferenceTest, WaitsForRunningInferences) {
+  OpenVINOAsyncInference inferences;
+  inferences.Begin();
+  EXPECT_EQ(kTfLiteError, inferences.Wait(std::chrono::milliseconds(10)));
+  std::thread completion([&] { inferences.End(kTfLiteOk); });
+  EXPECT_EQ(kTfLiteOk, inferences.Wait(std::chrono::milliseconds(-1)));
+  completion.join();
+  EXPECT_EQ(inferences.getInFlight(), 0);
+}
+
+TEST(OpenVINOAsyncInferenceTest, ReportsToCallback) {
+  OpenVINOAsyncInference inferences;
+  std::vector<TfLiteStatus> statuses;
+  inferences.SetCallback(
+      [](void *user_data, TfLiteStatus status) {
+        static_cast<std::vector<TfLiteStatus> *>(user_data)->push_back(status);
+      },
+      &statuses);
+  inferences.Begin();
+  inferences.End(kTfLiteOk);
+  inferences.Begin();
+  inferences.End(kTfLiteError);
+  EXPECT_THAT(statuses, testing::ElementsAre(kTfLiteOk, kTfLiteError));
+}
+
+TEST(OpenVINOAsyncInferenceTest, OptsInWithCallback) {
+  OpenVINOAsyncInference inferences;
+  EXPECT_FALSE(inferences.hasCallback());
+  inferences.SetCallback([](void *, TfLiteStatus) {}, nullptr);
+  EXPECT_TRUE(inferences.hasCallback());
+  inferences.SetCallback(nullptr, nullptr);
+  EXPECT_FALSE(inferences.hasCallback());
+}
+
+TEST(OpenVINOAsyncInferenceTest, ReportsFailureOnce) {
+  OpenVINOAsyncInference inferences;
+  inferences.Begin();
+  inferences.End(kTfLiteError);
+  EXPECT_EQ(kTfLiteError, inferences.Wait(std::chrono::milliseconds(0)));
+  EXPECT_EQ(kTfLiteOk, inferences.Wait(std::chrono::milliseconds(0)));
+}
+
+}  // namespace openvinodelegate
+}  // namespace tflite
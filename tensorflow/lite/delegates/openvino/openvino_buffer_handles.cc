@@ -0,0 +1,95 @@
+// Copyright (C) 2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#include "openvino_buffer_handles.h"
+
+#include <cstdint>
+#include <cstring>
+#include <new>
+
+#include "tensorflow/lite/tools/logging.h"
+
+namespace tflite {
+namespace openvinodelegate {
+namespace {
+
+// ov::Allocator of kAlignment aligned host memory.
+struct AlignedAllocator {
+  void *allocate(size_t bytes, size_t) {
+    return ::operator new(
+        bytes, std::align_val_t(OpenVINOBufferHandles::kAlignment));
+  }
+  void deallocate(void *ptr, size_t, size_t) {
+    ::operator delete(ptr,
+                      std::align_val_t(OpenVINOBufferHandles::kAlignment));
+  }
+  bool is_equal(const AlignedAllocator &) const { return true; }
+};
+
+bool IsAligned(const ov::Tensor &tensor) {
+  return reinterpret_cast<uintptr_t>(tensor.data()) %
+             OpenVINOBufferHandles::kAlignment ==
+         0;
+}
+
+}  // namespace
+
+TfLiteBufferHandle OpenVINOBufferHandles::Create(ov::Core &core,
+                                                 const std::string &device,
+                                                 size_t byte_size) {
+  if (byte_size == 0) return kTfLiteNullBufferHandle;
+  ov::Tensor buffer;
+  try {
+    // Plugins without remote contexts, like CPU, throw here.
+    buffer = core.get_default_context(device).create_host_tensor(
+        ov::element::u8, ov::Shape{byte_size});
+  } catch (const std::exception &) {
+  }
+  try {
+    if (!buffer || !IsAligned(buffer))
+      buffer = ov::Tensor(ov::element::u8, ov::Shape{byte_size},
+                          ov::Allocator(AlignedAllocator{}));
+  } catch (const std::exception &e) {
+    TFLITE_LOG(ERROR) << "Unable to allocate a buffer of " << byte_size
+                      << " bytes: " << e.what() << "\n";
+    return kTfLiteNullBufferHandle;
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  TfLiteBufferHandle handle = next_handle_++;
+  buffers_[handle] = buffer;
+  return handle;
+}
+
+ov::Tensor OpenVINOBufferHandles::Get(TfLiteBufferHandle handle) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = buffers_.find(handle);
+  return it != buffers_.end() ? it->second : ov::Tensor();
+}
+
+void OpenVINOBufferHandles::Release(TfLiteBufferHandle handle) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  buffers_.erase(handle);
+}
+
+TfLiteStatus OpenVINOBufferHandles::CopyTo(TfLiteBufferHandle handle,
+                                           const void *data, size_t size) {
+  ov::Tensor buffer = Get(handle);
+  if (!buffer || data == nullptr || size != buffer.get_byte_size())
+    return kTfLiteError;
+  if (buffer.data() != data) std::memcpy(buffer.data(), data, size);
+  return kTfLiteOk;
+}
+
+TfLiteStatus OpenVINOBufferHandles::CopyFrom(TfLiteBufferHandle handle,
+                                             void *data, size_t size) {
+  ov::Tensor buffer = Get(handle);
+  if (!buffer || data == nullptr || size != buffer.get_byte_size())
+    return kTfLiteError;
+  if (buffer.data() != data) std::memcpy(data, buffer.data(), size);
+  return kTfLiteOk;
+}
+
+}  // namespace openvinodelegate
+}  // namespace tflite
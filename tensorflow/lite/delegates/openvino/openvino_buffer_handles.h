@@ -0,0 +1,61 @@
+// Copyright (C) 2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef TENSORFLOW_LITE_DELEGATES_OPENVINO_BUFFER_HANDLES_H_
+#define TENSORFLOW_LITE_DELEGATES_OPENVINO_BUFFER_HANDLES_H_
+#include <map>
+#include <mutex>
+#include <openvino/openvino.hpp>
+#include <openvino/runtime/core.hpp>
+#include <string>
+
+#include "tensorflow/lite/c/common.h"
+
+namespace tflite {
+namespace openvinodelegate {
+
+// Buffers allocated by OpenVINO for boundary tensors, indexed by the
+// TfLiteBufferHandle handed out to the application.
+//
+// A buffer is meant to be registered as the custom allocation of its tensor
+// as well, so that the kernels bind it to the infer request without copies
+// and the application reads and writes OpenVINO memory directly. CopyTo and
+// CopyFrom only copy when a tensor is backed by other memory.
+class OpenVINOBufferHandles {
+ public:
+  // TFLite requires custom allocations to be aligned to this many bytes.
+  static constexpr size_t kAlignment = 64;
+
+  // Allocates byte_size bytes of host memory, from the default remote context
+  // of device when its plugin has one so that the device can access it
+  // directly. Returns kTfLiteNullBufferHandle on failure.
+  TfLiteBufferHandle Create(ov::Core &core, const std::string &device,
+                            size_t byte_size);
+
+  // Returns the buffer of handle, an empty tensor if there is none.
+  ov::Tensor Get(TfLiteBufferHandle handle);
+
+  void Release(TfLiteBufferHandle handle);
+
+  // Copies size bytes of data into the buffer of handle.
+  TfLiteStatus CopyTo(TfLiteBufferHandle handle, const void *data,
+                      size_t size);
+
+  // Copies the buffer of handle into size bytes at data.
+  TfLiteStatus CopyFrom(TfLiteBufferHandle handle, void *data, size_t size);
+
+  size_t getCount() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return buffers_.size();
+  }
+
+ private:
+  std::mutex mutex_;
+  std::map<TfLiteBufferHandle, ov::Tensor> buffers_;
+  TfLiteBufferHandle next_handle_ = 0;
+};
+
+}  // namespace openvinodelegate
+}  // namespace tflite
+#endif  // TENSORFLOW_LITE_DELEGATES_OPENVINO_BUFFER_HANDLES_H_
@@ -0,0 +1,62 @@
+// Copyright (C) 2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#include "openvino_buffer_handles.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace tflite {
+namespace openvinodelegate {
+
+TEST(OpenVINOBufferHandlesTest, CreatesAlignedBuffers) {
+  ov::Core core;
+  OpenVINOBufferHandles buffers;
+  TfLiteBufferHandle first = buffers.Create(core, "CPU", 100);
+  TfLiteBufferHandle second = buffers.Create(core, "CPU", 3);
+  ASSERT_NE(first, kTfLiteNullBufferHandle);
+  ASSERT_NE(second, kTfLiteNullBufferHandle);
+  EXPECT_NE(first, second);
+  EXPECT_EQ(buffers.getCount(), 2);
+  EXPECT_EQ(buffers.Get(first).get_byte_size(), 100);
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(buffers.Get(second).data()) %
+                OpenVINOBufferHandles::kAlignment,
+            0);
+}
+
+TEST(OpenVINOBufferHandlesTest, RejectsEmptyBuffers) {
+  ov::Core core;
+  OpenVINOBufferHandles buffers;
+  EXPECT_EQ(buffers.Create(core, "CPU", 0), kTfLiteNullBufferHandle);
+}
+
+TEST(OpenVINOBufferHandlesTest, CopiesToAndFrom) {
+  ov::Core core;
+  OpenVINOBufferHandles buffers;
+  TfLiteBufferHandle handle = buffers.Create(core, "CPU", 4);
+  std::vector<uint8_t> written = {1, 2, 3, 4};
+  ASSERT_EQ(buffers.CopyTo(handle, written.data(), written.size()),
+            kTfLiteOk);
+  std::vector<uint8_t> read(4);
+  ASSERT_EQ(buffers.CopyFrom(handle, read.data(), read.size()), kTfLiteOk);
+  EXPECT_EQ(read, written);
+  EXPECT_EQ(buffers.CopyFrom(handle, read.data(), 2), kTfLiteError);
+}
+
+TEST(OpenVINOBufferHandlesTest, ReleasesBuffers) {
+  ov::Core core;
+  OpenVINOBufferHandles buffers;
+  TfLiteBufferHandle handle = buffers.Create(core, "CPU", 8);
+  buffers.Release(handle);
+  EXPECT_EQ(buffers.getCount(), 0);
+  EXPECT_FALSE(buffers.Get(handle));
+  std::vector<uint8_t> data(8);
+  EXPECT_EQ(buffers.CopyTo(handle, data.data(), data.size()), kTfLiteError);
+}
+
+}  // namespace openvinodelegate
+}  // namespace tflite
@@ -0,0 +1,54 @@
+// Copyright (C) 2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#include "openvino_compile_pool.h"
+
+#include <algorithm>
+
+namespace tflite {
+namespace openvinodelegate {
+
+OpenVINOCompilePool::OpenVINOCompilePool(size_t max_workers)
+    : max_workers_(max_workers != 0
+                       ? max_workers
+                       : std::max(1u, std::thread::hardware_concurrency())) {}
+
+OpenVINOCompilePool::~OpenVINOCompilePool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+  tasks_available_.notify_all();
+  for (std::thread &worker : workers_) worker.join();
+}
+
+void OpenVINOCompilePool::Enqueue(std::function<void()> task) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    tasks_.push_back(std::move(task));
+    if (idle_workers_ < tasks_.size() && workers_.size() < max_workers_)
+      workers_.emplace_back(&OpenVINOCompilePool::WorkerLoop, this);
+  }
+  tasks_available_.notify_one();
+}
+
+void OpenVINOCompilePool::WorkerLoop() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    idle_workers_++;
+    tasks_available_.wait(lock,
+                          [this] { return stopping_ || !tasks_.empty(); });
+    idle_workers_--;
+    // Queued tasks are drained before stopping, their futures must be set.
+    if (tasks_.empty()) return;
+    std::function<void()> task = std::move(tasks_.front());
+    tasks_.pop_front();
+    lock.unlock();
+    task();
+    lock.lock();
+  }
+}
+
+}  // namespace openvinodelegate
+}  // namespace tflite
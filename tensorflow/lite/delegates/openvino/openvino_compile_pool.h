@@ -0,0 +1,58 @@
+// Copyright (C) 2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef TENSORFLOW_LITE_DELEGATES_OPENVINO_COMPILE_POOL_H_
+#define TENSORFLOW_LITE_DELEGATES_OPENVINO_COMPILE_POOL_H_
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace tflite {
+namespace openvinodelegate {
+
+// Fixed-size pool of threads compiling delegate partitions. At most
+// max_workers tasks run at the same time, which bounds the peak memory taken
+// by concurrent compile_model calls. Threads are started on demand.
+class OpenVINOCompilePool {
+ public:
+  // max_workers of 0 selects the number of hardware threads.
+  explicit OpenVINOCompilePool(size_t max_workers);
+
+  // Waits for the queued tasks to finish.
+  ~OpenVINOCompilePool();
+
+  template <typename Task>
+  std::future<std::invoke_result_t<Task>> Submit(Task task) {
+    auto packaged =
+        std::make_shared<std::packaged_task<std::invoke_result_t<Task>()>>(
+            std::move(task));
+    std::future<std::invoke_result_t<Task>> result = packaged->get_future();
+    Enqueue([packaged] { (*packaged)(); });
+    return result;
+  }
+
+  size_t getMaxWorkers() const { return max_workers_; }
+
+ private:
+  void Enqueue(std::function<void()> task);
+  void WorkerLoop();
+
+  size_t max_workers_;
+  std::mutex mutex_;
+  std::condition_variable tasks_available_;
+  std::deque<std::function<void()>> tasks_;
+  size_t idle_workers_ = 0;
+  bool stopping_ = false;
+  std::vector<std::thread> workers_;
+};
+
+}  // namespace openvinodelegate
+}  // namespace tflite
+#endif  // TENSORFLOW_LITE_DELEGATES_OPENVINO_COMPILE_POOL_H_
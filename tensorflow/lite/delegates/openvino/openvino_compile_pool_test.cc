@@ -0,0 +1,59 @@
+// Copyright (C) 2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#include "openvino_compile_pool.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <vector>
+
+namespace tflite {
+namespace openvinodelegate {
+
+TEST(OpenVINOCompilePoolTest, ReturnsTaskResults) {
+  OpenVINOCompilePool pool(2);
+  std::vector<std::future<int>> results;
+  for (int i = 0; i < 8; i++) results.push_back(pool.Submit([i] { return i; }));
+  for (int i = 0; i < 8; i++) EXPECT_EQ(i, results[i].get());
+}
+
+TEST(OpenVINOCompilePoolTest, BoundsConcurrentTasks) {
+  OpenVINOCompilePool pool(3);
+  std::atomic<int> running{0};
+  std::atomic<int> max_running{0};
+  std::vector<std::future<void>> results;
+  for (int i = 0; i < 12; i++) {
+    results.push_back(pool.Submit([&] {
+      int now = ++running;
+      int seen = max_running;
+      while (now > seen && !max_running.compare_exchange_weak(seen, now)) {
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(5));
+      running--;
+    }));
+  }
+  for (auto &result : results) result.get();
+  EXPECT_LE(max_running, 3);
+  EXPECT_GE(max_running, 1);
+}
+
+TEST(OpenVINOCompilePoolTest, DrainsTasksOnDestruction) {
+  std::atomic<int> completed{0};
+  {
+    OpenVINOCompilePool pool(1);
+    for (int i = 0; i < 4; i++) pool.Submit([&] { completed++; });
+  }
+  EXPECT_EQ(4, completed);
+}
+
+TEST(OpenVINOCompilePoolTest, DefaultsToHardwareThreads) {
+  OpenVINOCompilePool pool(0);
+  EXPECT_GE(pool.getMaxWorkers(), 1);
+}
+
+}  // namespace openvinodelegate
+}  // namespace tflite
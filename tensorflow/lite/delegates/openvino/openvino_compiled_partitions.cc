@@ -0,0 +1,312 @@
+// Copyright (C) 2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#include "openvino_compiled_partitions.h"
+
+#include <cstring>
+#include <sstream>
+#include <vector>
+
+#include "openvino_model_cache.h"
+#include "tensorflow/lite/tools/logging.h"
+
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
+namespace tflite {
+namespace openvinodelegate {
+
+namespace {
+
+constexpr char kContainerMagic[8] = {'O', 'V', 'T', 'F', 'L', 'B', 'L', 'B'};
+
+void WriteString(std::ostream &stream, const std::string &value) {
+  uint64_t size = value.size();
+  stream.write(reinterpret_cast<const char *>(&size), sizeof(size));
+  stream.write(value.data(), size);
+}
+
+// Bytes between the read position of stream and its end, 0 if the stream
+// cannot seek.
+uint64_t RemainingBytes(std::istream &stream) {
+  const std::streampos position = stream.tellg();
+  if (position < 0 || !stream.seekg(0, std::ios_base::end)) return 0;
+  const std::streampos end = stream.tellg();
+  stream.seekg(position);
+  return end > position ? static_cast<uint64_t>(end - position) : 0;
+}
+
+// Lengths are checked against the stream, a corrupt one must not allocate.
+bool ReadString(std::istream &stream, std::string &value) {
+  uint64_t size = 0;
+  if (!stream.read(reinterpret_cast<char *>(&size), sizeof(size))) return false;
+  if (size > RemainingBytes(stream)) return false;
+  value.resize(size);
+  return static_cast<bool>(stream.read(value.data(), size));
+}
+
+}  // namespace
+
+void OpenVINOCompiledPartitions::Register(
+    const std::string &key, const ov::CompiledModel &compiled_model) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  compiled_models_[key] = compiled_model;
+}
+
+void OpenVINOCompiledPartitions::AddPrepared(
+    const std::string &key, std::shared_future<PreparedPartition> prepared) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  prepared_[key] = std::move(prepared);
+}
+
+std::shared_future<OpenVINOCompiledPartitions::PreparedPartition>
+OpenVINOCompiledPartitions::GetPrepared(const std::string &key) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = prepared_.find(key);
+  // Kept for other kernels of identical partitions, they share the model.
+  return it != prepared_.end() ? it->second
+                               : std::shared_future<PreparedPartition>();
+}
+
+std::shared_ptr<OpenVINOInferRequestPool>
+OpenVINOCompiledPartitions::GetInferRequestPool(
+    const std::string &key, const ov::CompiledModel &compiled_model,
+    size_t size) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::shared_ptr<OpenVINOInferRequestPool> &pool = infer_request_pools_[key];
+  if (pool == nullptr)
+    pool = std::make_shared<OpenVINOInferRequestPool>(compiled_model, size);
+  return pool;
+}
+
+std::shared_ptr<OpenVINOInferRequestPool>
+OpenVINOCompiledPartitions::FindInferRequestPool(const std::string &key) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto pool = infer_request_pools_.find(key);
+  return pool != infer_request_pools_.end() ? pool->second : nullptr;
+}
+
+std::shared_ptr<OpenVINORequestBatcher> OpenVINOCompiledPartitions::FindBatcher(
+    const std::string &key) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto batcher = batchers_.find(key);
+  return batcher != batchers_.end() ? batcher->second : nullptr;
+}
+
+std::shared_ptr<OpenVINORequestBatcher> OpenVINOCompiledPartitions::AddBatcher(
+    const std::string &key, std::shared_ptr<OpenVINORequestBatcher> batcher) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return batchers_.emplace(key, std::move(batcher)).first->second;
+}
+
+OpenVINORequestBatcher::Stats OpenVINOCompiledPartitions::getBatchStats() {
+  std::vector<std::shared_ptr<OpenVINORequestBatcher>> batchers;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto &[key, batcher] : batchers_) batchers.push_back(batcher);
+  }
+  OpenVINORequestBatcher::Stats total;
+  for (auto &batcher : batchers) {
+    OpenVINORequestBatcher::Stats stats = batcher->getStats();
+    total.batches += stats.batches;
+    total.requests += stats.requests;
+    total.total_wait += stats.total_wait;
+    total.total_latency += stats.total_latency;
+  }
+  return total;
+}
+
+bool OpenVINOCompiledPartitions::IsReady() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (auto &[key, prepared] : prepared_) {
+    if (prepared.wait_for(std::chrono::seconds(0)) !=
+        std::future_status::ready)
+      return false;
+  }
+  return true;
+}
+
+void OpenVINOCompiledPartitions::TrimReleased() {
+  if (preparing_ != 0 || !released_untrimmed_.exchange(false)) return;
+#ifdef __GLIBC__
+  // Hands the freed constants back to the system rather than to the heap.
+  malloc_trim(0);
+#endif
+}
+
+TfLiteStatus OpenVINOCompiledPartitions::WaitUntilReady(
+    std::chrono::milliseconds timeout) {
+  std::vector<std::shared_future<PreparedPartition>> pending;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto &[key, prepared] : prepared_) pending.push_back(prepared);
+  }
+  const auto deadline = std::chrono::steady_clock::now() + timeout;
+  for (auto &prepared : pending) {
+    if (timeout.count() < 0) {
+      prepared.wait();
+    } else if (prepared.wait_until(deadline) != std::future_status::ready) {
+      return kTfLiteError;
+    }
+    if (!prepared.get().compiled) return kTfLiteError;
+  }
+  return kTfLiteOk;
+}
+
+bool OpenVINOCompiledPartitions::Import(const std::string &key, ov::Core &core,
+                                        const std::string &device,
+                                        ov::CompiledModel &compiled_model) {
+  std::string blob;
+  std::shared_ptr<MappedBlob> mapped_container;
+  MappedRange range = {0, 0};
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto mapped = mapped_blobs_.find(key);
+    auto it = precompiled_blobs_.find(key);
+    if (mapped != mapped_blobs_.end()) {
+      mapped_container = mapped_container_;
+      range = mapped->second;
+      mapped_blobs_.erase(mapped);
+    } else if (it != precompiled_blobs_.end()) {
+      // Every partition is imported once, the blob is dead weight afterwards.
+      blob = std::move(it->second);
+      precompiled_blobs_.erase(it);
+    } else {
+      return false;
+    }
+  }
+
+  try {
+    if (mapped_container != nullptr) {
+      compiled_model =
+          mapped_container->Import(core, device, range.offset, range.size);
+    } else {
+      std::istringstream stream(std::move(blob));
+      compiled_model = core.import_model(stream, device);
+    }
+  } catch (const std::exception &e) {
+    TFLITE_LOG(ERROR) << "Unable to import precompiled partition " << key
+                      << ": " << e.what() << "\n";
+    return false;
+  }
+  return true;
+}
+
+TfLiteStatus OpenVINOCompiledPartitions::Serialize(std::ostream &stream) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (compiled_models_.empty()) {
+    TFLITE_LOG(ERROR) << "No compiled partitions to export\n";
+    return kTfLiteError;
+  }
+
+  uint32_t version = kContainerVersion;
+  uint32_t delegate_version = OpenVINOModelCache::kDelegateCacheVersion;
+  uint64_t count = compiled_models_.size();
+  stream.write(kContainerMagic, sizeof(kContainerMagic));
+  stream.write(reinterpret_cast<const char *>(&version), sizeof(version));
+  stream.write(reinterpret_cast<const char *>(&delegate_version),
+               sizeof(delegate_version));
+  WriteString(stream, ov::get_openvino_version().buildNumber);
+  stream.write(reinterpret_cast<const char *>(&count), sizeof(count));
+
+  for (auto &[key, compiled_model] : compiled_models_) {
+    std::ostringstream blob;
+    try {
+      compiled_model.export_model(blob);
+    } catch (const std::exception &e) {
+      TFLITE_LOG(ERROR) << "Unable to export partition " << key << ": "
+                        << e.what() << "\n";
+      return kTfLiteError;
+    }
+    WriteString(stream, key);
+    WriteString(stream, blob.str());
+  }
+  return stream.good() ? kTfLiteOk : kTfLiteError;
+}
+
+TfLiteStatus OpenVINOCompiledPartitions::Deserialize(std::istream &stream) {
+  return ParseContainer(stream, /*copy_blobs=*/true);
+}
+
+TfLiteStatus OpenVINOCompiledPartitions::Map(const std::string &path) {
+  std::shared_ptr<MappedBlob> container = MappedBlob::Open(path);
+  if (container == nullptr) return kTfLiteError;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    mapped_container_ = container;
+  }
+  MemoryStreamBuf buffer(container->data(), container->size());
+  std::istream stream(&buffer);
+  return ParseContainer(stream, /*copy_blobs=*/false);
+}
+
+TfLiteStatus OpenVINOCompiledPartitions::ParseContainer(std::istream &stream,
+                                                        bool copy_blobs) {
+  char magic[sizeof(kContainerMagic)];
+  uint32_t version = 0;
+  if (!stream.read(magic, sizeof(magic)) ||
+      std::memcmp(magic, kContainerMagic, sizeof(magic)) != 0 ||
+      !stream.read(reinterpret_cast<char *>(&version), sizeof(version))) {
+    TFLITE_LOG(ERROR) << "Not an OpenVINO delegate precompiled container\n";
+    return kTfLiteError;
+  }
+  if (version != kContainerVersion) {
+    TFLITE_LOG(ERROR) << "Unsupported precompiled container version "
+                      << version << "\n";
+    return kTfLiteError;
+  }
+  uint32_t delegate_version = 0;
+  if (!stream.read(reinterpret_cast<char *>(&delegate_version),
+                   sizeof(delegate_version)))
+    return kTfLiteError;
+  if (delegate_version != OpenVINOModelCache::kDelegateCacheVersion) {
+    TFLITE_LOG(WARN) << "Precompiled container was exported by delegate "
+                     << "version " << delegate_version
+                     << ", recompiling all partitions\n";
+    return kTfLiteError;
+  }
+
+  std::string runtime;
+  if (!ReadString(stream, runtime)) return kTfLiteError;
+  if (runtime != ov::get_openvino_version().buildNumber) {
+    TFLITE_LOG(WARN) << "Precompiled container was exported with OpenVINO "
+                     << runtime << ", recompiling all partitions\n";
+    return kTfLiteError;
+  }
+
+  uint64_t count = 0;
+  if (!stream.read(reinterpret_cast<char *>(&count), sizeof(count)))
+    return kTfLiteError;
+  std::map<std::string, std::string> blobs;
+  std::map<std::string, MappedRange> ranges;
+  for (uint64_t i = 0; i < count; i++) {
+    std::string key, blob;
+    bool valid = ReadString(stream, key);
+    if (valid && copy_blobs) {
+      valid = ReadString(stream, blob);
+      blobs[key] = std::move(blob);
+    } else if (valid) {
+      uint64_t size = 0;
+      valid = static_cast<bool>(
+          stream.read(reinterpret_cast<char *>(&size), sizeof(size)));
+      valid = valid && size <= RemainingBytes(stream);
+      size_t offset = stream.tellg();
+      valid = valid && stream.seekg(size, std::ios_base::cur);
+      ranges[key] = {offset, size};
+    }
+    if (!valid) {
+      TFLITE_LOG(ERROR) << "Truncated precompiled container\n";
+      return kTfLiteError;
+    }
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  precompiled_blobs_ = std::move(blobs);
+  mapped_blobs_ = std::move(ranges);
+  return kTfLiteOk;
+}
+
+}  // namespace openvinodelegate
+}  // namespace tflite
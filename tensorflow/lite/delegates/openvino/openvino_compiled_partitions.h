@@ -0,0 +1,221 @@
+// Copyright (C) 2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef TENSORFLOW_LITE_DELEGATES_OPENVINO_COMPILED_PARTITIONS_H_
+#define TENSORFLOW_LITE_DELEGATES_OPENVINO_COMPILED_PARTITIONS_H_
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <openvino/openvino.hpp>
+#include <openvino/runtime/core.hpp>
+#include <string>
+#include <vector>
+
+#include "openvino_infer_request_pool.h"
+#include "openvino_mapped_blob.h"
+#include "openvino_request_batcher.h"
+#include "tensorflow/lite/c/common.h"
+
+namespace tflite {
+namespace openvinodelegate {
+
+// Compiled partitions of one delegate instance, indexed by the partition key
+// of OpenVINOModelCache::ComputeKey.
+//
+// Kernels register their ov::CompiledModel once compiled so that all
+// partitions can be exported into a single container, and kernels of a
+// delegate created from such a container import their blob from here instead
+// of building and compiling the partition. Partitions compiled ahead of
+// their kernel by OpenVINODelegate::Initialize are handed over from here too.
+//
+// Container layout, all integers in host byte order:
+//   char[8]  magic "OVTFLBLB"
+//   uint32   format version
+//   uint32   OpenVINOModelCache::kDelegateCacheVersion of the exporter
+//   string   OpenVINO runtime build the blobs were exported with
+//   uint64   number of partitions
+//   per partition: string key, string exported ov::CompiledModel
+// where string is a uint64 length followed by the bytes.
+class OpenVINOCompiledPartitions {
+ public:
+  static constexpr uint32_t kContainerVersion = 2;
+
+  // Result of compiling or importing a partition on the compile pool.
+  struct PreparedPartition {
+    bool compiled = false;
+    ov::CompiledModel compiled_model;
+    // Mapping compiled_model was imported from, must be kept alive with it.
+    std::shared_ptr<MappedBlob> mapped_blob;
+  };
+
+  void Register(const std::string &key,
+                const ov::CompiledModel &compiled_model);
+
+  // Records a partition that is being compiled ahead of its kernel.
+  void AddPrepared(const std::string &key,
+                   std::shared_future<PreparedPartition> prepared);
+
+  // Returns the compilation recorded under key by AddPrepared, or an invalid
+  // future if there is none.
+  std::shared_future<PreparedPartition> GetPrepared(const std::string &key);
+
+  // Returns the infer requests of the partition key, shared by the kernels of
+  // all interpreters the delegate is applied to. The pool is created for
+  // compiled_model with size requests the first time the key is requested.
+  std::shared_ptr<OpenVINOInferRequestPool> GetInferRequestPool(
+      const std::string &key, const ov::CompiledModel &compiled_model,
+      size_t size);
+
+  // Returns the infer requests GetInferRequestPool created for key, null if
+  // it was not requested yet.
+  std::shared_ptr<OpenVINOInferRequestPool> FindInferRequestPool(
+      const std::string &key);
+
+  // Batcher shared by the kernels of all interpreters running the partition
+  // key, null if none was added yet. AddBatcher returns the batcher of key,
+  // which is batcher unless another kernel added one first.
+  std::shared_ptr<OpenVINORequestBatcher> FindBatcher(const std::string &key);
+  std::shared_ptr<OpenVINORequestBatcher> AddBatcher(
+      const std::string &key, std::shared_ptr<OpenVINORequestBatcher> batcher);
+
+  // Sum of the counters of every batcher.
+  OpenVINORequestBatcher::Stats getBatchStats();
+
+  // Whether every partition recorded by AddPrepared finished compiling.
+  bool IsReady();
+
+  // Waits up to timeout for the partitions recorded by AddPrepared, forever
+  // for a negative timeout. Fails on timeout or if one of them failed.
+  TfLiteStatus WaitUntilReady(std::chrono::milliseconds timeout);
+
+  // Whether the loaded container holds a blob for the partition key.
+  bool HasPrecompiled(const std::string &key) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return precompiled_blobs_.count(key) != 0 || mapped_blobs_.count(key) != 0;
+  }
+
+  // Imports the precompiled blob of the partition key, returns false if the
+  // loaded container has none or the blob cannot be imported.
+  bool Import(const std::string &key, ov::Core &core, const std::string &device,
+              ov::CompiledModel &compiled_model);
+
+  // Writes every registered partition into the container format above.
+  TfLiteStatus Serialize(std::ostream &stream);
+
+  // Loads a container written by Serialize. Containers of another format
+  // version or OpenVINO runtime are rejected, in which case every partition
+  // falls back to regular compilation.
+  TfLiteStatus Deserialize(std::istream &stream);
+
+  // Same as Deserialize, but maps the container file read-only and imports
+  // the partitions straight from the mapping, so that processes loading the
+  // same container share its pages instead of holding private copies.
+  TfLiteStatus Map(const std::string &path);
+
+  size_t getRegisteredCount() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return compiled_models_.size();
+  }
+
+  // Counters of tiered compilation: invocations of partitions that ran on
+  // their fast tier and on their optimized tier, and the longest time a
+  // partition spent on its fast tier before switching.
+  void RecordTieredInvocation(bool optimized) {
+    (optimized ? optimized_tier_invocations_ : fast_tier_invocations_)++;
+  }
+
+  void RecordTierSwitch(std::chrono::milliseconds after) {
+    int64_t switch_ms = tier_switch_ms_;
+    while (after.count() > switch_ms &&
+           !tier_switch_ms_.compare_exchange_weak(switch_ms, after.count())) {
+    }
+  }
+
+  uint64_t getFastTierInvocations() const { return fast_tier_invocations_; }
+
+  uint64_t getOptimizedTierInvocations() const {
+    return optimized_tier_invocations_;
+  }
+
+  int64_t getTierSwitchMs() const { return tier_switch_ms_; }
+
+  // Bytes of the constants of the models built for partitions, and of those
+  // that reused an identical constant instead of another copy.
+  void RecordConstants(uint64_t bytes, uint64_t deduplicated_bytes) {
+    constant_bytes_ += bytes;
+    deduplicated_constant_bytes_ += deduplicated_bytes;
+  }
+
+  uint64_t getConstantBytes() const { return constant_bytes_; }
+
+  uint64_t getDeduplicatedConstantBytes() const {
+    return deduplicated_constant_bytes_;
+  }
+
+  // Resident memory of the process before and after a partition released
+  // the model it was compiled from, see release_models.
+  struct Release {
+    std::string key;
+    int64_t resident_before;
+    int64_t resident_after;
+  };
+
+  void RecordRelease(Release release) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    releases_.push_back(std::move(release));
+  }
+
+  std::vector<Release> getReleases() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return releases_;
+  }
+
+  // Models released without record_release_stats leave their memory in the
+  // heap until TrimReleased hands it back to the system. Trimming walks the
+  // whole heap, so it is done once the partitions are compiled rather than
+  // per release: by the last background compilation to end, and by kernels
+  // preparing after they compiled in Init.
+  void MarkReleased() { released_untrimmed_ = true; }
+  void BeginPreparing() { preparing_++; }
+  void EndPreparing() {
+    preparing_--;
+    TrimReleased();
+  }
+  // Does nothing while background compilations are running.
+  void TrimReleased();
+
+ private:
+  // Offset and size of a blob inside mapped_container_.
+  struct MappedRange {
+    size_t offset;
+    size_t size;
+  };
+
+  TfLiteStatus ParseContainer(std::istream &stream, bool copy_blobs);
+
+  std::mutex mutex_;
+  std::map<std::string, ov::CompiledModel> compiled_models_;
+  std::map<std::string, std::string> precompiled_blobs_;
+  std::shared_ptr<MappedBlob> mapped_container_;
+  std::map<std::string, MappedRange> mapped_blobs_;
+  std::map<std::string, std::shared_future<PreparedPartition>> prepared_;
+  std::map<std::string, std::shared_ptr<OpenVINOInferRequestPool>>
+      infer_request_pools_;
+  std::map<std::string, std::shared_ptr<OpenVINORequestBatcher>> batchers_;
+  std::vector<Release> releases_;
+  std::atomic<bool> released_untrimmed_{false};
+  std::atomic<int> preparing_{0};
+  std::atomic<uint64_t> fast_tier_invocations_{0};
+  std::atomic<uint64_t> optimized_tier_invocations_{0};
+  std::atomic<int64_t> tier_switch_ms_{-1};
+  std::atomic<uint64_t> constant_bytes_{0};
+  std::atomic<uint64_t> deduplicated_constant_bytes_{0};
+};
+
+}  // namespace openvinodelegate
+}  // namespace tflite
+#endif  // TENSORFLOW_LITE_DELEGATES_OPENVINO_COMPILED_PARTITIONS_H_
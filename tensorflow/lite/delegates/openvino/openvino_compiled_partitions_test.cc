@@ -0,0 +1,163 @@
+// Copyright (C) 2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#include "openvino_compiled_partitions.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+#include "openvino_test_model.h"
+
+namespace tflite {
+namespace openvinodelegate {
+
+class OpenVINOCompiledPartitionsTest : public OpenVINOCompiledModelTest {};
+
+TEST_F(OpenVINOCompiledPartitionsTest, SerializeWithoutPartitions) {
+  OpenVINOCompiledPartitions partitions;
+  std::stringstream container;
+  EXPECT_EQ(kTfLiteError, partitions.Serialize(container));
+}
+
+TEST_F(OpenVINOCompiledPartitionsTest, RoundTrip) {
+  OpenVINOCompiledPartitions exported;
+  exported.Register("0123456789abcdef", compiled_model_);
+  std::stringstream container;
+  ASSERT_EQ(kTfLiteOk, exported.Serialize(container));
+
+  OpenVINOCompiledPartitions imported;
+  ASSERT_EQ(kTfLiteOk, imported.Deserialize(container));
+  ov::CompiledModel compiled_model;
+  EXPECT_FALSE(imported.Import("fedcba9876543210", core_, "CPU",
+                               compiled_model));
+  EXPECT_TRUE(imported.Import("0123456789abcdef", core_, "CPU",
+                              compiled_model));
+  EXPECT_EQ(compiled_model.inputs().size(), 1);
+}
+
+TEST_F(OpenVINOCompiledPartitionsTest, MappedRoundTrip) {
+  const std::string path =
+      (std::filesystem::path(testing::TempDir()) / "partitions.ovblob")
+          .string();
+  OpenVINOCompiledPartitions exported;
+  exported.Register("0123456789abcdef", compiled_model_);
+  {
+    std::ofstream container(path, std::ios::binary | std::ios::trunc);
+    ASSERT_EQ(kTfLiteOk, exported.Serialize(container));
+  }
+
+  OpenVINOCompiledPartitions imported;
+  ASSERT_EQ(kTfLiteOk, imported.Map(path));
+  ov::CompiledModel compiled_model;
+  EXPECT_TRUE(imported.Import("0123456789abcdef", core_, "CPU",
+                              compiled_model));
+  EXPECT_EQ(compiled_model.inputs().size(), 1);
+  std::filesystem::remove(path);
+}
+
+TEST_F(OpenVINOCompiledPartitionsTest, RejectsForeignContainer) {
+  OpenVINOCompiledPartitions partitions;
+  std::stringstream container("not a precompiled container");
+  EXPECT_EQ(kTfLiteError, partitions.Deserialize(container));
+}
+
+TEST_F(OpenVINOCompiledPartitionsTest, RejectsOtherRuntime) {
+  OpenVINOCompiledPartitions exported;
+  exported.Register("0123456789abcdef", compiled_model_);
+  std::stringstream container;
+  ASSERT_EQ(kTfLiteOk, exported.Serialize(container));
+
+  // Corrupt the runtime build string stored after magic, versions and
+  // length.
+  std::string bytes = container.str();
+  bytes[sizeof(uint64_t) + 2 * sizeof(uint32_t) + sizeof(uint64_t)] ^= 0x1;
+  std::stringstream modified(bytes);
+
+  OpenVINOCompiledPartitions imported;
+  EXPECT_EQ(kTfLiteError, imported.Deserialize(modified));
+  ov::CompiledModel compiled_model;
+  EXPECT_FALSE(imported.Import("0123456789abcdef", core_, "CPU",
+                               compiled_model));
+}
+
+TEST_F(OpenVINOCompiledPartitionsTest, RejectsOtherDelegateVersion) {
+  OpenVINOCompiledPartitions exported;
+  exported.Register("0123456789abcdef", compiled_model_);
+  std::stringstream container;
+  ASSERT_EQ(kTfLiteOk, exported.Serialize(container));
+
+  // Corrupt the delegate version stored after magic and format version.
+  std::string bytes = container.str();
+  bytes[sizeof(uint64_t) + sizeof(uint32_t)] ^= 0x1;
+  std::stringstream modified(bytes);
+
+  OpenVINOCompiledPartitions imported;
+  EXPECT_EQ(kTfLiteError, imported.Deserialize(modified));
+}
+
+TEST_F(OpenVINOCompiledPartitionsTest, RejectsTruncatedContainer) {
+  OpenVINOCompiledPartitions exported;
+  exported.Register("0123456789abcdef", compiled_model_);
+  std::stringstream container;
+  ASSERT_EQ(kTfLiteOk, exported.Serialize(container));
+  const std::string bytes = container.str();
+
+  std::stringstream truncated(bytes.substr(0, bytes.size() - 16));
+  OpenVINOCompiledPartitions imported;
+  EXPECT_EQ(kTfLiteError, imported.Deserialize(truncated));
+  ov::CompiledModel compiled_model;
+  EXPECT_FALSE(imported.Import("0123456789abcdef", core_, "CPU",
+                               compiled_model));
+}
+
+TEST_F(OpenVINOCompiledPartitionsTest, RejectsCorruptLength) {
+  OpenVINOCompiledPartitions exported;
+  exported.Register("0123456789abcdef", compiled_model_);
+  const std::string path =
+      (std::filesystem::path(testing::TempDir()) / "corrupt.ovblob").string();
+  std::stringstream container;
+  ASSERT_EQ(kTfLiteOk, exported.Serialize(container));
+
+  // Overwrite the length of the blob, after the runtime build string, the
+  // partition count and the key, with a huge one.
+  std::string bytes = container.str();
+  size_t offset = sizeof(uint64_t) + 2 * sizeof(uint32_t);
+  uint64_t runtime_size = 0;
+  std::memcpy(&runtime_size, &bytes[offset], sizeof(runtime_size));
+  offset += sizeof(uint64_t) + runtime_size + 2 * sizeof(uint64_t) + 16;
+  const uint64_t size = ~0ULL;
+  std::memcpy(&bytes[offset], &size, sizeof(size));
+  std::stringstream modified(bytes);
+  OpenVINOCompiledPartitions imported;
+  EXPECT_EQ(kTfLiteError, imported.Deserialize(modified));
+
+  {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file << bytes;
+  }
+  OpenVINOCompiledPartitions mapped;
+  EXPECT_EQ(kTfLiteError, mapped.Map(path));
+  std::filesystem::remove(path);
+}
+
+TEST_F(OpenVINOCompiledPartitionsTest, KeepsReleasesInOrder) {
+  OpenVINOCompiledPartitions partitions;
+  EXPECT_TRUE(partitions.getReleases().empty());
+  partitions.RecordRelease({"0123456789abcdef", 4096, 1024});
+  partitions.RecordRelease({"fedcba9876543210", 2048, 2048});
+  const auto releases = partitions.getReleases();
+  ASSERT_EQ(2, releases.size());
+  EXPECT_EQ("0123456789abcdef", releases[0].key);
+  EXPECT_EQ(4096, releases[0].resident_before);
+  EXPECT_EQ(1024, releases[0].resident_after);
+  EXPECT_EQ("fedcba9876543210", releases[1].key);
+}
+
+}  // namespace openvinodelegate
+}  // namespace tflite
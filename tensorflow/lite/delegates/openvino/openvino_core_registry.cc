@@ -0,0 +1,28 @@
+// Copyright (C) 2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#include "openvino_core_registry.h"
+
+#include <map>
+
+namespace tflite {
+namespace openvinodelegate {
+
+std::shared_ptr<OpenVINOSharedCore> OpenVINOCoreRegistry::Acquire(
+    const std::string &plugins_path) {
+  static std::mutex *registry_mutex = new std::mutex;
+  static auto *cores =
+      new std::map<std::string, std::weak_ptr<OpenVINOSharedCore>>;
+
+  std::lock_guard<std::mutex> lock(*registry_mutex);
+  std::shared_ptr<OpenVINOSharedCore> core = (*cores)[plugins_path].lock();
+  if (core == nullptr) {
+    core = std::make_shared<OpenVINOSharedCore>(plugins_path);
+    (*cores)[plugins_path] = core;
+  }
+  return core;
+}
+
+}  // namespace openvinodelegate
+}  // namespace tflite
@@ -0,0 +1,50 @@
+// Copyright (C) 2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef TENSORFLOW_LITE_DELEGATES_OPENVINO_CORE_REGISTRY_H_
+#define TENSORFLOW_LITE_DELEGATES_OPENVINO_CORE_REGISTRY_H_
+#include <memory>
+#include <mutex>
+#include <openvino/openvino.hpp>
+#include <openvino/runtime/core.hpp>
+#include <string>
+#include <vector>
+
+namespace tflite {
+namespace openvinodelegate {
+
+// ov::Core shared by every delegate instance and kernel of the process.
+// Plugins are loaded once per process and the device list is enumerated once
+// per core instead of once per partition.
+class OpenVINOSharedCore {
+ public:
+  explicit OpenVINOSharedCore(const std::string &plugins_path)
+      : core_(plugins_path) {}
+
+  ov::Core &getCore() { return core_; }
+
+  const std::vector<std::string> &getAvailableDevices() {
+    std::call_once(devices_once_, [this] {
+      available_devices_ = core_.get_available_devices();
+    });
+    return available_devices_;
+  }
+
+ private:
+  ov::Core core_;
+  std::once_flag devices_once_;
+  std::vector<std::string> available_devices_;
+};
+
+class OpenVINOCoreRegistry {
+ public:
+  // Returns the shared core for plugins_path, creating it if no delegate or
+  // kernel currently holds one. The core is released with its last holder.
+  static std::shared_ptr<OpenVINOSharedCore> Acquire(
+      const std::string &plugins_path);
+};
+
+}  // namespace openvinodelegate
+}  // namespace tflite
+#endif  // TENSORFLOW_LITE_DELEGATES_OPENVINO_CORE_REGISTRY_H_
@@ -4,6 +4,12 @@
 
 #include "openvino_delegate.h"
 
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <set>
+#include <sstream>
+
 #include "openvino/runtime/core.hpp"
 #include "tensorflow/lite/builtin_ops.h"
 #include "tensorflow/lite/c/builtin_op_data.h"
@@ -15,6 +21,135 @@
 
 namespace tflite {
 namespace openvinodelegate {
+namespace {
+
+std::string StringOrEmpty(const char *value) {
+  return value != nullptr ? value : "";
+}
+
+// Translates the delegate options into the settings of its kernels.
+OpenVINOKernelSettings GetKernelSettings(
+    const TfLiteOpenVINODelegateOptions &options) {
+  OpenVINOKernelSettings settings;
+  if (!StringOrEmpty(options.device_type).empty())
+    settings.device = options.device_type;
+  settings.tiered_compilation = options.tiered_compilation;
+  settings.zero_copy = options.zero_copy;
+  settings.num_infer_requests = std::max(0, options.num_infer_requests);
+  settings.dynamic_shapes = options.dynamic_shapes;
+  settings.share_constants = options.share_model_weights;
+  settings.release_models = options.release_models;
+  settings.record_release_stats = options.record_release_stats;
+  settings.max_batch_size = std::max(0, options.max_batch_size);
+  settings.batch_timeout =
+      std::chrono::microseconds(std::max(0, options.batch_timeout_us));
+  const std::string buckets = StringOrEmpty(options.shape_buckets);
+  if (!buckets.empty()) {
+    settings.shape_buckets =
+        OpenVINOShapeBuckets::Parse(buckets, options.bucket_axis);
+    if (settings.shape_buckets == nullptr)
+      TFLITE_LOG(WARN) << "Ignoring malformed shape buckets " << buckets
+                       << " for axis " << options.bucket_axis << "\n";
+  }
+  const std::string preprocessing = StringOrEmpty(options.preprocessing);
+  if (!preprocessing.empty()) {
+    settings.preprocessing = OpenVINOPreprocessing::Parse(preprocessing);
+    if (settings.preprocessing == nullptr)
+      TFLITE_LOG(WARN) << "Ignoring malformed preprocessing " << preprocessing
+                       << "\n";
+  }
+  const std::string static_inputs = StringOrEmpty(options.static_inputs);
+  settings.input_tracker = OpenVINOInputTracker::Parse(static_inputs);
+  if (settings.input_tracker == nullptr) {
+    TFLITE_LOG(WARN) << "Ignoring malformed static inputs " << static_inputs
+                     << "\n";
+    settings.input_tracker = OpenVINOInputTracker::Parse("");
+  }
+  if (settings.device == "NPU") {
+    settings.properties["NPU_COMPILATION_MODE_PARAMS"] =
+        std::string("enable-se-ptrs-operations=true");
+  }
+
+  const std::string hint = StringOrEmpty(options.performance_hint);
+  if (hint == "LATENCY" || hint == "THROUGHPUT" ||
+      hint == "CUMULATIVE_THROUGHPUT") {
+    settings.properties[ov::hint::performance_mode.name()] = hint;
+  } else if (!hint.empty()) {
+    TFLITE_LOG(WARN) << "Ignoring unknown performance hint " << hint << "\n";
+  }
+  if (options.num_streams != 0) {
+    settings.properties[ov::num_streams.name()] =
+        options.num_streams < 0 ? std::string("AUTO")
+                                : std::to_string(options.num_streams);
+  }
+  if (options.inference_num_threads > 0) {
+    settings.properties[ov::inference_num_threads.name()] =
+        std::to_string(options.inference_num_threads);
+  }
+
+  std::istringstream properties(StringOrEmpty(options.properties));
+  std::string property;
+  while (std::getline(properties, property, ';')) {
+    if (property.empty()) continue;
+    const size_t separator = property.find('=');
+    if (separator == std::string::npos || separator == 0) {
+      TFLITE_LOG(WARN) << "Ignoring malformed property " << property << "\n";
+      continue;
+    }
+    settings.properties[property.substr(0, separator)] =
+        property.substr(separator + 1);
+  }
+  return settings;
+}
+
+}  // namespace
+
+OpenVINODelegate::OpenVINODelegate(
+    const TfLiteOpenVINODelegateOptions *options)
+    : options_(options != nullptr ? *options
+                                  : TfLiteOpenVINODelegateOptionsDefault()),
+      plugins_path_(StringOrEmpty(options_.plugins_path)),
+      kernel_settings_(GetKernelSettings(options_)),
+      compiled_partitions_(std::make_shared<OpenVINOCompiledPartitions>()),
+      compile_pool_(std::make_shared<OpenVINOCompilePool>(
+          std::max(0, options_.max_concurrent_compiles))) {
+  shared_core_ = OpenVINOCoreRegistry::Acquire(plugins_path_);
+
+  // The caller owns the option strings, keep our own copies.
+  if (options_.cache_dir != nullptr) cache_dir_ = options_.cache_dir;
+  options_.cache_dir = cache_dir_.c_str();
+  options_.plugins_path = plugins_path_.c_str();
+  options_.device_type = kernel_settings_.device.c_str();
+  options_.performance_hint = nullptr;
+  options_.properties = nullptr;
+  options_.precompiled_model_path = nullptr;
+  options_.shape_buckets = nullptr;
+  options_.preprocessing = nullptr;
+  options_.static_inputs = nullptr;
+  if (!cache_dir_.empty()) {
+    model_cache_ = std::make_shared<OpenVINOModelCache>(
+        cache_dir_, options_.cache_max_size_bytes,
+        options_.mmap_compiled_blobs);
+  }
+
+  if (options != nullptr && options->precompiled_model_path != nullptr &&
+      options->precompiled_model_path[0] != '\0') {
+    TfLiteStatus status = kTfLiteError;
+    if (options_.mmap_compiled_blobs) {
+      status = compiled_partitions_->Map(options->precompiled_model_path);
+    } else {
+      std::ifstream container(options->precompiled_model_path,
+                              std::ios::binary);
+      if (container.is_open())
+        status = compiled_partitions_->Deserialize(container);
+    }
+    if (status != kTfLiteOk) {
+      TFLITE_LOG(WARN) << "Ignoring precompiled model "
+                       << options->precompiled_model_path << "\n";
+    }
+  }
+}
+
 bool OpenVINODelegate::CheckInputsType(const int tensor_id,
                                        const TfLiteOpaqueContext *context,
                                        TfLiteType expected_type) const {
@@ -211,27 +346,140 @@ bool OpenVINODelegate::IsNodeSupportedByDelegate(
 }
 
 TfLiteStatus OpenVINODelegate::Initialize(TfLiteOpaqueContext *context) {
+  // Build the models of all partitions the interpreter is about to hand over
+  // and compile them concurrently, kernels then pick up their compiled model
+  // instead of compiling one partition after the other.
+  TfLiteIntArray *execution_plan = nullptr;
+  if (TfLiteOpaqueContextGetExecutionPlan(context, &execution_plan) !=
+      kTfLiteOk)
+    return kTfLiteError;
+
+  std::vector<int> supported_nodes;
+  for (int i = 0; i < execution_plan->size; i++) {
+    const int node_id = execution_plan->data[i];
+    TfLiteOpaqueNode *node;
+    TfLiteRegistrationExternal *registration;
+    if (TfLiteOpaqueContextGetNodeAndRegistration(context, node_id, &node,
+                                                  &registration) != kTfLiteOk)
+      return kTfLiteError;
+    if (IsNodeSupportedByDelegate(registration, node, context))
+      supported_nodes.push_back(node_id);
+  }
+  delegates_whole_graph_ =
+      static_cast<int>(supported_nodes.size()) == execution_plan->size;
+  if (options_.async_inference && !delegates_whole_graph_)
+    TFLITE_LOG(WARN) << "Not every node is supported, running synchronously "
+                        "despite async_inference\n";
+  // Shape buckets and batched models are compiled by the kernels.
+  if (supported_nodes.empty() || kernel_settings_.shape_buckets != nullptr ||
+      kernel_settings_.max_batch_size > 1)
+    return kTfLiteOk;
+
+  std::unique_ptr<TfLiteIntArray, decltype(&TfLiteIntArrayFree)> nodes(
+      TfLiteIntArrayCreate(supported_nodes.size()), TfLiteIntArrayFree);
+  std::copy(supported_nodes.begin(), supported_nodes.end(), nodes->data);
+  TfLiteOpaqueDelegateParams *partitions = nullptr;
+  int num_partitions = 0;
+  if (TfLiteOpaqueContextPreviewDelegatePartitioning(
+          context, nodes.get(), &partitions, &num_partitions) != kTfLiteOk) {
+    TFLITE_LOG(WARN) << "Unable to preview partitions, compiling them in "
+                        "their kernels\n";
+    return kTfLiteOk;
+  }
+
+  std::set<std::string> scheduled;
+  for (int i = 0; i < num_partitions; i++) {
+    auto core = std::make_shared<OpenVINODelegateCore>(
+        plugins_path_, model_cache_, compiled_partitions_,
+        /*compile_pool=*/nullptr, kernel_settings_);
+    // A partition that fails here is built again by its kernel, which then
+    // reports the error. Partitions prepared for another interpreter are
+    // reused, with their infer requests.
+    if (core->PreparePartition(context, &partitions[i]) != kTfLiteOk ||
+        !scheduled.insert(core->getPartitionKey()).second ||
+        compiled_partitions_->GetPrepared(core->getPartitionKey()).valid())
+      continue;
+    compiled_partitions_->BeginPreparing();
+    compiled_partitions_->AddPrepared(
+        core->getPartitionKey(),
+        compile_pool_
+            ->Submit([core] { return core->CompilePreparedPartition(); })
+            .share());
+  }
   return kTfLiteOk;
 }
 
+TfLiteStatus OpenVINODelegate::CopyFromBufferHandle(
+    TfLiteOpaqueContext *context, TfLiteBufferHandle buffer_handle,
+    TfLiteOpaqueTensor *tensor) {
+  return buffer_handles_->CopyFrom(buffer_handle,
+                                   TfLiteOpaqueTensorData(tensor),
+                                   TfLiteOpaqueTensorByteSize(tensor));
+}
+
+TfLiteStatus OpenVINODelegate::CopyToBufferHandle(
+    TfLiteOpaqueContext *context, TfLiteBufferHandle buffer_handle,
+    const TfLiteOpaqueTensor *tensor) {
+  return buffer_handles_->CopyTo(buffer_handle, TfLiteOpaqueTensorData(tensor),
+                                 TfLiteOpaqueTensorByteSize(tensor));
+}
+
+void OpenVINODelegate::FreeBufferHandle(TfLiteOpaqueContext *context,
+                                        TfLiteBufferHandle *buffer_handle) {
+  buffer_handles_->Release(*buffer_handle);
+  *buffer_handle = kTfLiteNullBufferHandle;
+}
+
 const char *OpenVINODelegate::Name() const {
   return "OpenVINO SimpleOpaqueDelegate";
 }
 
+OpenVINOKernelSettings OpenVINODelegate::GetSettingsForKernel() const {
+  OpenVINOKernelSettings settings = kernel_settings_;
+  if (options_.async_inference && delegates_whole_graph_)
+    settings.async_inference = async_inference_;
+  return settings;
+}
+
 std::unique_ptr<tflite::SimpleOpaqueDelegateKernelInterface>
 OpenVINODelegate::CreateDelegateKernelInterface() {
   return std::unique_ptr<tflite::openvinodelegate::OpenVINODelegateKernel>(
-      new tflite::openvinodelegate::OpenVINODelegateKernel());
+      new tflite::openvinodelegate::OpenVINODelegateKernel(
+          model_cache_, compiled_partitions_,
+          options_.async_compilation || options_.tiered_compilation
+              ? compile_pool_
+              : nullptr,
+          GetSettingsForKernel(), plugins_path_));
 }
 }  // namespace openvinodelegate
 }  // namespace tflite
 
+namespace {
+
+// OpenVINODelegate behind delegate, null if delegate is.
+tflite::openvinodelegate::OpenVINODelegate *GetOpenVINODelegate(
+    TfLiteOpaqueDelegate *delegate) {
+  if (delegate == nullptr) return nullptr;
+  return static_cast<tflite::openvinodelegate::OpenVINODelegate *>(
+      TfLiteOpaqueDelegateGetData(delegate));
+}
+
+}  // namespace
+
 TfLiteDelegate *TFL_CAPI_EXPORT
 TfLiteCreateOpenVINODelegate(const TfLiteOpenVINODelegateOptions *options) {
   auto ovdelegate_ =
       std::make_unique<tflite::openvinodelegate::OpenVINODelegate>(options);
+  // TFLite propagates the dims of resized inputs through the replaced nodes,
+  // which leaves the outputs of the partitions sized for Prepare.
+  const bool resizable = ovdelegate_->getShapeBuckets() != nullptr ||
+                         (options != nullptr && options->dynamic_shapes);
+  const int64_t flags = resizable
+                            ? kTfLiteDelegateFlagsAllowDynamicTensors |
+                                  kTfLiteDelegateFlagsRequirePropagatedShapes
+                            : kTfLiteDelegateFlagsNone;
   return tflite::TfLiteOpaqueDelegateFactory::CreateSimpleDelegate(
-      std::move(ovdelegate_));
+      std::move(ovdelegate_), flags);
 }
 
 void TFL_CAPI_EXPORT
@@ -243,6 +491,218 @@ TfLiteOpenVINODelegateOptions TFL_CAPI_EXPORT
 TfLiteOpenVINODelegateOptionsDefault() {
   TfLiteOpenVINODelegateOptions result;
   result.debug_level = 0;
-  /* result.plugins_path = "/tmp/plugins.xml"; */
+  result.plugins_path = nullptr;
+  result.device_type = "CPU";
+  result.performance_hint = nullptr;
+  result.num_streams = 0;
+  result.inference_num_threads = 0;
+  result.properties = nullptr;
+  result.cache_dir = nullptr;
+  result.cache_max_size_bytes = 0;
+  result.precompiled_model_path = nullptr;
+  result.mmap_compiled_blobs = false;
+  result.max_concurrent_compiles = 0;
+  result.async_compilation = false;
+  result.tiered_compilation = false;
+  result.zero_copy = true;
+  result.num_infer_requests = 0;
+  result.async_inference = false;
+  result.dynamic_shapes = false;
+  result.shape_buckets = nullptr;
+  result.bucket_axis = 1;
+  result.max_batch_size = 0;
+  result.batch_timeout_us = 1000;
+  result.preprocessing = nullptr;
+  result.static_inputs = nullptr;
+  result.share_model_weights = false;
+  result.release_models = true;
+  result.record_release_stats = false;
   return result;
 }
+
+TfLiteStatus TFL_CAPI_EXPORT TfLiteOpenVINODelegateGetCacheStats(
+    TfLiteOpaqueDelegate *delegate, uint64_t *hits, uint64_t *misses) {
+  if (hits == nullptr || misses == nullptr) return kTfLiteError;
+  auto *ov_delegate = GetOpenVINODelegate(delegate);
+  if (ov_delegate == nullptr) return kTfLiteError;
+  auto model_cache = ov_delegate->getModelCache();
+  *hits = model_cache != nullptr ? model_cache->getHits() : 0;
+  *misses = model_cache != nullptr ? model_cache->getMisses() : 0;
+  return kTfLiteOk;
+}
+
+TfLiteStatus TFL_CAPI_EXPORT TfLiteOpenVINODelegateExportCompiledModel(
+    TfLiteOpaqueDelegate *delegate, const char *path) {
+  if (path == nullptr) return kTfLiteError;
+  auto *ov_delegate = GetOpenVINODelegate(delegate);
+  if (ov_delegate == nullptr) return kTfLiteError;
+
+  // Partitions still compiling in the background would be missing from the
+  // container, so wait for all of them rather than export a partial one.
+  auto compiled_partitions = ov_delegate->getCompiledPartitions();
+  if (compiled_partitions->WaitUntilReady(std::chrono::milliseconds(-1)) !=
+      kTfLiteOk) {
+    TFLITE_LOG(ERROR) << "Not every partition compiled, nothing exported\n";
+    return kTfLiteError;
+  }
+  std::ofstream container(path, std::ios::binary | std::ios::trunc);
+  if (!container.is_open()) {
+    TFLITE_LOG(ERROR) << "Unable to open " << path << " for writing\n";
+    return kTfLiteError;
+  }
+  return compiled_partitions->Serialize(container);
+}
+
+TfLiteStatus TFL_CAPI_EXPORT TfLiteOpenVINODelegateIsReady(
+    TfLiteOpaqueDelegate *delegate, bool *ready) {
+  if (ready == nullptr) return kTfLiteError;
+  auto *ov_delegate = GetOpenVINODelegate(delegate);
+  if (ov_delegate == nullptr) return kTfLiteError;
+  *ready = ov_delegate->getCompiledPartitions()->IsReady();
+  return kTfLiteOk;
+}
+
+TfLiteStatus TFL_CAPI_EXPORT TfLiteOpenVINODelegateWaitUntilReady(
+    TfLiteOpaqueDelegate *delegate, int64_t timeout_ms) {
+  auto *ov_delegate = GetOpenVINODelegate(delegate);
+  if (ov_delegate == nullptr) return kTfLiteError;
+  return ov_delegate->getCompiledPartitions()->WaitUntilReady(
+      std::chrono::milliseconds(timeout_ms));
+}
+
+TfLiteStatus TFL_CAPI_EXPORT TfLiteOpenVINODelegateGetTierStats(
+    TfLiteOpaqueDelegate *delegate, uint64_t *fast_tier_invocations,
+    uint64_t *optimized_tier_invocations, int64_t *tier_switch_ms) {
+  if (fast_tier_invocations == nullptr ||
+      optimized_tier_invocations == nullptr || tier_switch_ms == nullptr)
+    return kTfLiteError;
+  auto *ov_delegate = GetOpenVINODelegate(delegate);
+  if (ov_delegate == nullptr) return kTfLiteError;
+  auto compiled_partitions = ov_delegate->getCompiledPartitions();
+  *fast_tier_invocations = compiled_partitions->getFastTierInvocations();
+  *optimized_tier_invocations =
+      compiled_partitions->getOptimizedTierInvocations();
+  *tier_switch_ms = compiled_partitions->getTierSwitchMs();
+  return kTfLiteOk;
+}
+
+TfLiteStatus TFL_CAPI_EXPORT TfLiteOpenVINODelegateGetConstantStats(
+    TfLiteOpaqueDelegate *delegate, uint64_t *constant_bytes,
+    uint64_t *deduplicated_bytes) {
+  if (constant_bytes == nullptr || deduplicated_bytes == nullptr)
+    return kTfLiteError;
+  auto *ov_delegate = GetOpenVINODelegate(delegate);
+  if (ov_delegate == nullptr) return kTfLiteError;
+  auto compiled_partitions = ov_delegate->getCompiledPartitions();
+  *constant_bytes = compiled_partitions->getConstantBytes();
+  *deduplicated_bytes = compiled_partitions->getDeduplicatedConstantBytes();
+  return kTfLiteOk;
+}
+
+TfLiteStatus TFL_CAPI_EXPORT TfLiteOpenVINODelegateGetReleaseStats(
+    TfLiteOpaqueDelegate *delegate, int partition,
+    int64_t *resident_before_bytes, int64_t *resident_after_bytes) {
+  if (resident_before_bytes == nullptr || resident_after_bytes == nullptr)
+    return kTfLiteError;
+  auto *ov_delegate = GetOpenVINODelegate(delegate);
+  if (ov_delegate == nullptr) return kTfLiteError;
+  const auto releases = ov_delegate->getCompiledPartitions()->getReleases();
+  if (partition < 0 || static_cast<size_t>(partition) >= releases.size())
+    return kTfLiteError;
+  *resident_before_bytes = releases[partition].resident_before;
+  *resident_after_bytes = releases[partition].resident_after;
+  return kTfLiteOk;
+}
+
+TfLiteStatus TFL_CAPI_EXPORT TfLiteOpenVINODelegateGetBucketStats(
+    TfLiteOpaqueDelegate *delegate, int bucket, int64_t *length,
+    uint64_t *hits) {
+  if (length == nullptr || hits == nullptr) return kTfLiteError;
+  auto *ov_delegate = GetOpenVINODelegate(delegate);
+  if (ov_delegate == nullptr) return kTfLiteError;
+  auto shape_buckets = ov_delegate->getShapeBuckets();
+  if (shape_buckets == nullptr || bucket < 0 ||
+      static_cast<size_t>(bucket) >= shape_buckets->getCount())
+    return kTfLiteError;
+  *length = shape_buckets->getLength(bucket);
+  *hits = shape_buckets->getHits(bucket);
+  return kTfLiteOk;
+}
+
+TfLiteStatus TFL_CAPI_EXPORT TfLiteOpenVINODelegateGetBatchStats(
+    TfLiteOpaqueDelegate *delegate, uint64_t *batches, uint64_t *requests,
+    int64_t *mean_wait_us, int64_t *mean_latency_us) {
+  if (batches == nullptr || requests == nullptr || mean_wait_us == nullptr ||
+      mean_latency_us == nullptr)
+    return kTfLiteError;
+  auto *ov_delegate = GetOpenVINODelegate(delegate);
+  if (ov_delegate == nullptr) return kTfLiteError;
+  const tflite::openvinodelegate::OpenVINORequestBatcher::Stats stats =
+      ov_delegate->getCompiledPartitions()->getBatchStats();
+  *batches = stats.batches;
+  *requests = stats.requests;
+  *mean_wait_us =
+      stats.requests != 0 ? stats.total_wait.count() / stats.requests : 0;
+  *mean_latency_us =
+      stats.requests != 0 ? stats.total_latency.count() / stats.requests : 0;
+  return kTfLiteOk;
+}
+
+TfLiteStatus TFL_CAPI_EXPORT TfLiteOpenVINODelegateMarkInputUnchanged(
+    TfLiteOpaqueDelegate *delegate, int tensor_index) {
+  if (tensor_index < 0) return kTfLiteError;
+  auto *ov_delegate = GetOpenVINODelegate(delegate);
+  if (ov_delegate == nullptr) return kTfLiteError;
+  ov_delegate->getInputTracker()->MarkUnchanged(tensor_index);
+  return kTfLiteOk;
+}
+
+TfLiteStatus TFL_CAPI_EXPORT TfLiteOpenVINODelegateGetInputCopyStats(
+    TfLiteOpaqueDelegate *delegate, uint64_t *bytes_copied,
+    uint64_t *bytes_skipped) {
+  if (bytes_copied == nullptr || bytes_skipped == nullptr) return kTfLiteError;
+  auto *ov_delegate = GetOpenVINODelegate(delegate);
+  if (ov_delegate == nullptr) return kTfLiteError;
+  *bytes_copied = ov_delegate->getInputTracker()->getBytesCopied();
+  *bytes_skipped = ov_delegate->getInputTracker()->getBytesSkipped();
+  return kTfLiteOk;
+}
+
+TfLiteStatus TFL_CAPI_EXPORT TfLiteOpenVINODelegateCreateBuffer(
+    TfLiteOpaqueDelegate *delegate, size_t byte_size,
+    TfLiteBufferHandle *handle, TfLiteCustomAllocation *allocation) {
+  if (handle == nullptr || allocation == nullptr) return kTfLiteError;
+  auto *ov_delegate = GetOpenVINODelegate(delegate);
+  if (ov_delegate == nullptr) return kTfLiteError;
+  *handle = ov_delegate->CreateBuffer(byte_size);
+  if (*handle == kTfLiteNullBufferHandle) return kTfLiteError;
+  ov::Tensor buffer = ov_delegate->getBufferHandles()->Get(*handle);
+  allocation->data = buffer.data();
+  allocation->bytes = buffer.get_byte_size();
+  return kTfLiteOk;
+}
+
+TfLiteStatus TFL_CAPI_EXPORT TfLiteOpenVINODelegateReleaseBuffer(
+    TfLiteOpaqueDelegate *delegate, TfLiteBufferHandle handle) {
+  auto *ov_delegate = GetOpenVINODelegate(delegate);
+  if (ov_delegate == nullptr) return kTfLiteError;
+  ov_delegate->getBufferHandles()->Release(handle);
+  return kTfLiteOk;
+}
+
+TfLiteStatus TFL_CAPI_EXPORT TfLiteOpenVINODelegateSetCompletionCallback(
+    TfLiteOpaqueDelegate *delegate, TfLiteOpenVINOCompletionCallback callback,
+    void *user_data) {
+  auto *ov_delegate = GetOpenVINODelegate(delegate);
+  if (ov_delegate == nullptr) return kTfLiteError;
+  ov_delegate->getAsyncInference()->SetCallback(callback, user_data);
+  return kTfLiteOk;
+}
+
+TfLiteStatus TFL_CAPI_EXPORT TfLiteOpenVINODelegateWaitForCompletion(
+    TfLiteOpaqueDelegate *delegate, int64_t timeout_ms) {
+  auto *ov_delegate = GetOpenVINODelegate(delegate);
+  if (ov_delegate == nullptr) return kTfLiteError;
+  return ov_delegate->getAsyncInference()->Wait(
+      std::chrono::milliseconds(timeout_ms));
+}
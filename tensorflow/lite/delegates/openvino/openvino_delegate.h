@@ -5,6 +5,8 @@
 #ifndef TENSORFLOW_LITE_DELEGATES_OPENVINO_DELEGATE_H_
 #define TENSORFLOW_LITE_DELEGATES_OPENVINO_DELEGATE_H_
 
+#include "openvino_buffer_handles.h"
+#include "openvino_compile_pool.h"
 #include "openvino_delegate_kernel.h"
 #include "tensorflow/lite/c/common.h"
 #include "tensorflow/lite/delegates/utils/simple_opaque_delegate.h"
@@ -20,13 +22,172 @@ struct TFL_CAPI_EXPORT TfLiteOpenVINODelegateOptions {
   /* debug_level for the OpenVINO delegate*/
   int debug_level;
 
-  /* path for the OpenVINO plugins
-  char *plugins_path; */
+  /* path of the plugins.xml to load OpenVINO plugins from. The default
+     configuration of the OpenVINO installation is used when null or empty. */
+  const char *plugins_path;
 
-  /* Device for OpenVINO to select
-      Currently we support CPU and NPU
-  char* device_type*/
-  ;
+  /* Device for OpenVINO to compile partitions for, e.g. CPU, GPU, NPU or
+     AUTO. Defaults to CPU. */
+  const char *device_type;
+
+  /* ov::hint::performance_mode of compiled partitions: LATENCY, THROUGHPUT
+     or CUMULATIVE_THROUGHPUT. The plugin default applies when null or
+     empty. */
+  const char *performance_hint;
+
+  /* ov::num_streams of compiled partitions, -1 selects AUTO and 0 keeps the
+     plugin default. */
+  int num_streams;
+
+  /* ov::inference_num_threads of compiled partitions, 0 keeps the plugin
+     default. */
+  int inference_num_threads;
+
+  /* Additional compile_model properties as KEY=VALUE pairs separated by
+     semicolons, e.g. "ENABLE_CPU_PINNING=NO;CPU_DENORMALS_OPTIMIZATION=YES".
+     They take precedence over the fields above. */
+  const char *properties;
+
+  /* Directory where compiled partitions are cached across runs.
+     Caching is disabled when null or empty. */
+  const char *cache_dir;
+
+  /* Upper bound in bytes for the blobs kept in cache_dir. The least recently
+     used blobs are evicted beyond it, 0 means unbounded. */
+  int64_t cache_max_size_bytes;
+
+  /* Container written by TfLiteOpenVINODelegateExportCompiledModel. Matching
+     partitions are imported from it instead of being compiled; partitions
+     without a matching blob, or all of them if the container was produced by
+     another OpenVINO runtime, are compiled as usual. */
+  const char *precompiled_model_path;
+
+  /* Map cached blobs and the precompiled container read-only and import
+     from the mapping, so that processes loading the same file share the
+     compiled weights through the page cache. */
+  bool mmap_compiled_blobs;
+
+  /* Number of partitions compiled concurrently while the delegate is
+     applied. Lower it to bound the peak memory of compilation, 0 selects the
+     number of hardware threads. */
+  int max_concurrent_compiles;
+
+  /* Return from ModifyGraphWithDelegate once the partitions are built and
+     compile them in the background. The first Invoke waits for compilations
+     that are still running, TfLiteOpenVINODelegateIsReady and
+     TfLiteOpenVINODelegateWaitUntilReady report their progress. */
+  bool async_compilation;
+
+  /* Run partitions on a quickly compiled CPU model until their compilation
+     for the target device completes, then switch to the latter between two
+     invocations. Has no effect for partitions targeting CPU or imported
+     from a cache or precompiled container. */
+  bool tiered_compilation;
+
+  /* Bind the buffers of TFLite input and output tensors to the infer
+     request instead of copying them on every invocation. Buffers of another
+     size or misaligned for their element type are still copied. Enabled by
+     default. */
+  bool zero_copy;
+
+  /* Number of infer requests of each compiled partition, shared by the
+     interpreters the delegate is applied to so that they can invoke it
+     concurrently, e.g. on the streams of the THROUGHPUT hint. 0 takes the
+     optimal number reported by the device. */
+  int num_infer_requests;
+
+  /* Return from Invoke once inference has started instead of once it
+     completed, so that the application can prepare the inputs of the next
+     invocation meanwhile. Only applies while a callback is set with
+     TfLiteOpenVINODelegateSetCompletionCallback, Invoke otherwise keeps
+     returning with the outputs written. Outputs must not be read before the
+     callback was called or TfLiteOpenVINODelegateWaitForCompletion
+     returned; the next Invoke waits for the previous inference itself. Only
+     applies when the delegate takes the whole graph, other interpreters run
+     synchronously. */
+  bool async_inference;
+
+  /* Compile the partitions with dynamic batch and spatial axes, every input
+     axis but the innermost one, so that inputs can be resized with
+     ResizeInputTensor and AllocateTensors without compiling them again.
+     Operations with a fixed target shape, e.g. RESHAPE, still require the
+     dims they were converted with. */
+  bool dynamic_shapes;
+
+  /* Comma separated lengths, e.g. "32,64,128", that axis bucket_axis of the
+     partition inputs is zero-padded to instead of compiling them with
+     dynamic shapes. Each partition is compiled once per bucket, on the first
+     invocation with inputs that fit it, and its outputs are cropped to the
+     dims TFLite propagated from the unpadded inputs. Inputs are resized as
+     with dynamic_shapes, but only along bucket_axis and up to the largest
+     bucket. Every input with more than bucket_axis axes is padded, so they
+     should share that axis, e.g. the sequence of an NLP model. Takes
+     precedence over dynamic_shapes. */
+  const char *shape_buckets;
+
+  /* Input axis padded to shape_buckets, 1 by default. */
+  int bucket_axis;
+
+  /* Above 1, stack the invocations that interpreters sharing the delegate
+     make concurrently, each on a batch of 1, into one inference of the
+     partition compiled for this many rows. Partitions whose inputs or
+     outputs do not all have a batch of 1 run unbatched, as do those of a
+     delegate with dynamic_shapes or shape_buckets. Invocations then always
+     complete synchronously, whatever async_inference says. */
+  int max_batch_size;
+
+  /* Longest an invocation waits for others to fill its batch, in
+     microseconds. 1000 by default. Not waited for while a single
+     interpreter uses the partition. */
+  int batch_timeout_us;
+
+  /* Image preprocessing folded into the compiled partitions, as KEY=VALUE
+     pairs separated by semicolons, e.g.
+     "element_type=u8;color_format=BGR;mean=127.5;scale=127.5". The inputs
+     it applies to, 4D float32 NHWC inputs, are then fed raw frames: the
+     application writes them into the tensor buffer instead of the
+     converted values. Keys are
+       input         tensor index of the input, every one if omitted
+       element_type  of the frames, u8 (default) or f32
+       color_format  of the frames, RGB (default), BGR or NV12 in a single
+                     plane, converted to RGB
+       mean, scale   per channel or one for all, subtracted from and then
+                     dividing the converted frames
+       resize        HxW of the frames, resized linearly to the input dims
+     Frames larger than the float32 tensor, e.g. with resize, must be backed
+     by a custom allocation of their size. Ignored with dynamic_shapes or
+     shape_buckets. */
+  const char *preprocessing;
+
+  /* Comma separated tensor indices of inputs that rarely change, e.g. a
+     reference embedding table or a static mask. Their buffers are
+     checksummed on every invocation and only copied into the infer request
+     when the checksum changed; see also
+     TfLiteOpenVINODelegateMarkInputUnchanged. Indices apply to every
+     interpreter the delegate is applied to, each partition compares its own
+     checksums. Inputs bound with zero_copy, the default, and batched
+     invocations are never tracked. */
+  const char *static_inputs;
+
+  /* Build the constants of the partitions over the weights of the TFLite
+     model instead of copies of them, so that the weights are not held twice
+     while the partitions are compiled. The TFLite model must then outlive
+     the delegate, as compiled partitions may keep reading them. Layout
+     conversions of shared weights are not folded at build time but left to
+     the plugin. */
+  bool share_model_weights;
+
+  /* Free the OpenVINO model of each partition and the state used to build
+     it, constants included, once the partition is compiled, so that only
+     the compiled model stays resident. Enabled by default; partitions of
+     shape_buckets keep their model to compile further buckets from it. */
+  bool release_models;
+
+  /* Sample the resident memory of the process around each release of
+     release_models, for TfLiteOpenVINODelegateGetReleaseStats, and log it.
+     Reads /proc and trims the heap per release rather than once all
+     partitions are compiled, meant for benchmarking. */
+  bool record_release_stats;
 };
 
 TfLiteOpenVINODelegateOptions TFL_CAPI_EXPORT
@@ -38,6 +199,115 @@ TfLiteCreateOpenVINODelegate(const TfLiteOpenVINODelegateOptions *options);
 void TFL_CAPI_EXPORT
 TfLiteDeleteOpenVINODelegate(TfLiteOpaqueDelegate *delegate);
 
+/* Reports how many partitions were served from / missed in the compiled-model
+   cache of a delegate created by TfLiteCreateOpenVINODelegate. */
+TfLiteStatus TFL_CAPI_EXPORT TfLiteOpenVINODelegateGetCacheStats(
+    TfLiteOpaqueDelegate *delegate, uint64_t *hits, uint64_t *misses);
+
+/* Serializes the compiled model of every partition of delegate into a single
+   versioned container at path. Must be called after the delegate has been
+   applied to an interpreter, waits for partitions still compiling in the
+   background and fails if one of them did not compile. */
+TfLiteStatus TFL_CAPI_EXPORT TfLiteOpenVINODelegateExportCompiledModel(
+    TfLiteOpaqueDelegate *delegate, const char *path);
+
+/* Sets *ready to whether every partition of delegate has been compiled. */
+TfLiteStatus TFL_CAPI_EXPORT TfLiteOpenVINODelegateIsReady(
+    TfLiteOpaqueDelegate *delegate, bool *ready);
+
+/* Blocks until every partition of delegate has been compiled or timeout_ms
+   elapsed, a negative timeout_ms waits indefinitely. Returns kTfLiteError on
+   timeout or if a partition failed to compile. */
+TfLiteStatus TFL_CAPI_EXPORT TfLiteOpenVINODelegateWaitUntilReady(
+    TfLiteOpaqueDelegate *delegate, int64_t timeout_ms);
+
+/* Retrieves the tiered compilation counters of delegate: invocations that ran
+   on fast and on optimized tiers, and the longest time in milliseconds a
+   partition ran on its fast tier before switching, -1 if none switched. */
+TfLiteStatus TFL_CAPI_EXPORT TfLiteOpenVINODelegateGetTierStats(
+    TfLiteOpaqueDelegate *delegate, uint64_t *fast_tier_invocations,
+    uint64_t *optimized_tier_invocations, int64_t *tier_switch_ms);
+
+/* Retrieves the bytes of constant tensors in the partitions built by
+   delegate, and how many of those reused the constant of an identical tensor
+   instead of being copied again. */
+TfLiteStatus TFL_CAPI_EXPORT TfLiteOpenVINODelegateGetConstantStats(
+    TfLiteOpaqueDelegate *delegate, uint64_t *constant_bytes,
+    uint64_t *deduplicated_bytes);
+
+/* Retrieves the resident memory of the process in bytes right before and
+   after the partition-th release of release_models, in the order the
+   partitions were compiled. Partitions compiling concurrently are included
+   in both. Returns kTfLiteError if fewer partitions were released, or
+   without record_release_stats. */
+TfLiteStatus TFL_CAPI_EXPORT TfLiteOpenVINODelegateGetReleaseStats(
+    TfLiteOpaqueDelegate *delegate, int partition,
+    int64_t *resident_before_bytes, int64_t *resident_after_bytes);
+
+/* Retrieves the length of shape bucket bucket of delegate and the number of
+   invocations that were padded to it. Returns kTfLiteError if delegate has
+   no such bucket. */
+TfLiteStatus TFL_CAPI_EXPORT TfLiteOpenVINODelegateGetBucketStats(
+    TfLiteOpaqueDelegate *delegate, int bucket, int64_t *length,
+    uint64_t *hits);
+
+/* Retrieves the counters of max_batch_size: the batches run, the
+   invocations they held, requests / (batches * max_batch_size) being their
+   occupancy, and the mean time in microseconds invocations waited for their
+   batch to start and to complete. */
+TfLiteStatus TFL_CAPI_EXPORT TfLiteOpenVINODelegateGetBatchStats(
+    TfLiteOpaqueDelegate *delegate, uint64_t *batches, uint64_t *requests,
+    int64_t *mean_wait_us, int64_t *mean_latency_us);
+
+/* Declares that the buffer of input tensor_index holds the same content as
+   for the previous invocation, so that the next invocation of each
+   partition reading it skips copying it into the infer request when that
+   request still holds it. The mark covers tensor_index in every interpreter
+   delegate is applied to. Has no effect on inputs bound with zero_copy, the
+   default, which are never copied. */
+TfLiteStatus TFL_CAPI_EXPORT TfLiteOpenVINODelegateMarkInputUnchanged(
+    TfLiteOpaqueDelegate *delegate, int tensor_index);
+
+/* Retrieves the number of input bytes copied into infer requests, and of
+   those skipped as unchanged, see static_inputs. */
+TfLiteStatus TFL_CAPI_EXPORT TfLiteOpenVINODelegateGetInputCopyStats(
+    TfLiteOpaqueDelegate *delegate, uint64_t *bytes_copied,
+    uint64_t *bytes_skipped);
+
+/* Allocates byte_size bytes of OpenVINO memory for a boundary tensor of an
+   interpreter delegate is applied to. Registering *allocation as the custom
+   allocation of the tensor and *handle as its buffer handle lets the
+   application read and write that memory directly, and the kernels bind it
+   to the infer request without copies. TFLite frees the buffer through the
+   FreeBufferHandle hook of delegate, or TfLiteOpenVINODelegateReleaseBuffer
+   does if no buffer handle was set. */
+TfLiteStatus TFL_CAPI_EXPORT TfLiteOpenVINODelegateCreateBuffer(
+    TfLiteOpaqueDelegate *delegate, size_t byte_size,
+    TfLiteBufferHandle *handle, TfLiteCustomAllocation *allocation);
+
+/* Frees a buffer created by TfLiteOpenVINODelegateCreateBuffer. */
+TfLiteStatus TFL_CAPI_EXPORT TfLiteOpenVINODelegateReleaseBuffer(
+    TfLiteOpaqueDelegate *delegate, TfLiteBufferHandle handle);
+
+/* Called from an OpenVINO thread once an inference started by an Invoke with
+   async_inference completed and its outputs were written, with the status of
+   the inference. Must not invoke the interpreter. */
+typedef void (*TfLiteOpenVINOCompletionCallback)(void *user_data,
+                                                 TfLiteStatus status);
+
+/* Sets the completion callback of delegate, null to remove it. Invocations
+   started after the callback is removed complete synchronously again. */
+TfLiteStatus TFL_CAPI_EXPORT TfLiteOpenVINODelegateSetCompletionCallback(
+    TfLiteOpaqueDelegate *delegate, TfLiteOpenVINOCompletionCallback callback,
+    void *user_data);
+
+/* Blocks until the inferences started with async_inference completed or
+   timeout_ms elapsed, a negative timeout_ms waits indefinitely. Returns
+   kTfLiteError on timeout or if one of the inferences completed since the
+   previous call failed. */
+TfLiteStatus TFL_CAPI_EXPORT TfLiteOpenVINODelegateWaitForCompletion(
+    TfLiteOpaqueDelegate *delegate, int64_t timeout_ms);
+
 namespace tflite {
 namespace openvinodelegate {
 
@@ -46,10 +316,7 @@ class OpenVINODelegateTestPeer;
 
 class OpenVINODelegate : public SimpleOpaqueDelegateInterface {
  public:
-  explicit OpenVINODelegate(const TfLiteOpenVINODelegateOptions *options)
-      : options_(*options) {
-    if (options == nullptr) options_ = TfLiteOpenVINODelegateOptionsDefault();
-  }
+  explicit OpenVINODelegate(const TfLiteOpenVINODelegateOptions *options);
 
   bool IsNodeSupportedByDelegate(const TfLiteRegistrationExternal *registration,
                                  const TfLiteOpaqueNode *node,
@@ -62,9 +329,71 @@ class OpenVINODelegate : public SimpleOpaqueDelegateInterface {
   std::unique_ptr<SimpleOpaqueDelegateKernelInterface>
   CreateDelegateKernelInterface() override;
 
+  // Buffer handle hooks for the buffers of getBufferHandles(). Copies are
+  // skipped when the tensor is backed by the buffer itself.
+  TfLiteStatus CopyFromBufferHandle(TfLiteOpaqueContext *context,
+                                    TfLiteBufferHandle buffer_handle,
+                                    TfLiteOpaqueTensor *tensor) override;
+
+  TfLiteStatus CopyToBufferHandle(TfLiteOpaqueContext *context,
+                                  TfLiteBufferHandle buffer_handle,
+                                  const TfLiteOpaqueTensor *tensor) override;
+
+  void FreeBufferHandle(TfLiteOpaqueContext *context,
+                        TfLiteBufferHandle *buffer_handle) override;
+
+  // Allocates a buffer for a boundary tensor, see
+  // TfLiteOpenVINODelegateCreateBuffer.
+  TfLiteBufferHandle CreateBuffer(size_t byte_size) {
+    return buffer_handles_->Create(shared_core_->getCore(),
+                                   kernel_settings_.device, byte_size);
+  }
+
+  std::shared_ptr<OpenVINOBufferHandles> getBufferHandles() const {
+    return buffer_handles_;
+  }
+
+  std::shared_ptr<OpenVINOAsyncInference> getAsyncInference() const {
+    return async_inference_;
+  }
+
+  std::shared_ptr<OpenVINOShapeBuckets> getShapeBuckets() const {
+    return kernel_settings_.shape_buckets;
+  }
+
+  std::shared_ptr<OpenVINOInputTracker> getInputTracker() const {
+    return kernel_settings_.input_tracker;
+  }
+
+  std::shared_ptr<OpenVINOModelCache> getModelCache() const {
+    return model_cache_;
+  }
+
+  std::shared_ptr<OpenVINOCompiledPartitions> getCompiledPartitions() const {
+    return compiled_partitions_;
+  }
+
  private:
   TfLiteOpenVINODelegateOptions options_;
+  // Keeps the process-wide core alive between the kernels of this delegate.
+  std::shared_ptr<OpenVINOSharedCore> shared_core_;
+  std::string plugins_path_;
+  OpenVINOKernelSettings kernel_settings_;
+  std::string cache_dir_;
+  std::shared_ptr<OpenVINOModelCache> model_cache_;
+  std::shared_ptr<OpenVINOCompiledPartitions> compiled_partitions_;
+  std::shared_ptr<OpenVINOBufferHandles> buffer_handles_ =
+      std::make_shared<OpenVINOBufferHandles>();
+  std::shared_ptr<OpenVINOAsyncInference> async_inference_ =
+      std::make_shared<OpenVINOAsyncInference>();
+  // Whether the last Initialize found every node supported, which
+  // async_inference requires as no TFLite kernel may read the outputs early.
+  bool delegates_whole_graph_ = false;
+  // Declared last so that pending compilations finish before the state they
+  // use is released.
+  std::shared_ptr<OpenVINOCompilePool> compile_pool_;
   friend class OpenVINODelegateTestPeer;
+  OpenVINOKernelSettings GetSettingsForKernel() const;
   bool CheckInputsType(const int tensor_id, const TfLiteOpaqueContext *context,
                        TfLiteType expected_type) const;
   bool CheckDataTypeSupported(
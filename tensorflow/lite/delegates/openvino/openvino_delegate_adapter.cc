@@ -30,16 +30,102 @@ TfLiteDelegate *CreateOVDelegateFromOptions(const char *const *options_keys,
   constexpr char kDebugLevel[] = "debug_level";
   constexpr char kPluginsPath[] = "plugins_path";
   constexpr char kDeviceType[] = "device_type";
+  constexpr char kPerformanceHint[] = "performance_hint";
+  constexpr char kNumStreams[] = "num_streams";
+  constexpr char kInferenceNumThreads[] = "inference_num_threads";
+  constexpr char kProperties[] = "properties";
+  constexpr char kCacheDir[] = "cache_dir";
+  constexpr char kCacheMaxSizeBytes[] = "cache_max_size_bytes";
+  constexpr char kPrecompiledModelPath[] = "precompiled_model_path";
+  constexpr char kMmapCompiledBlobs[] = "mmap_compiled_blobs";
+  constexpr char kMaxConcurrentCompiles[] = "max_concurrent_compiles";
+  constexpr char kAsyncCompilation[] = "async_compilation";
+  constexpr char kTieredCompilation[] = "tiered_compilation";
+  constexpr char kZeroCopy[] = "zero_copy";
+  constexpr char kNumInferRequests[] = "num_infer_requests";
+  constexpr char kAsyncInference[] = "async_inference";
+  constexpr char kDynamicShapes[] = "dynamic_shapes";
+  constexpr char kShapeBuckets[] = "shape_buckets";
+  constexpr char kBucketAxis[] = "bucket_axis";
+  constexpr char kMaxBatchSize[] = "max_batch_size";
+  constexpr char kBatchTimeoutUs[] = "batch_timeout_us";
+  constexpr char kPreprocessing[] = "preprocessing";
+  constexpr char kStaticInputs[] = "static_inputs";
+  constexpr char kShareModelWeights[] = "share_model_weights";
+  constexpr char kReleaseModels[] = "release_models";
+  constexpr char kRecordReleaseStats[] = "record_release_stats";
+
+  std::string plugins_path;
+  std::string device_type;
+  std::string performance_hint;
+  std::string properties;
+  std::string cache_dir;
+  std::string precompiled_model_path;
+  std::string shape_buckets;
+  std::string preprocessing;
+  std::string static_inputs;
 
   std::vector<tflite::Flag> flag_list = {
       tflite::Flag::CreateFlag(kDebugLevel, &options.debug_level,
                                "Debug Level for OpenVINO delegate."),
-      /*tflite::Flag::CreateFlag(kPluginsPath,
-                               &options.plugins_path,
-                               "Plugins.xml path.")
-      /*tflite::Flag::CreateFlag(kDeviceType,
-                               &options.device_type,
-                               "Device Type."), */
+      tflite::Flag::CreateFlag(kPluginsPath, &plugins_path,
+                               "Plugins.xml path."),
+      tflite::Flag::CreateFlag(kDeviceType, &device_type, "Device Type."),
+      tflite::Flag::CreateFlag(kPerformanceHint, &performance_hint,
+                               "LATENCY, THROUGHPUT or CUMULATIVE_THROUGHPUT."),
+      tflite::Flag::CreateFlag(kNumStreams, &options.num_streams,
+                               "Number of streams, -1 for AUTO."),
+      tflite::Flag::CreateFlag(kInferenceNumThreads,
+                               &options.inference_num_threads,
+                               "Number of inference threads."),
+      tflite::Flag::CreateFlag(kProperties, &properties,
+                               "KEY=VALUE;... compile_model properties."),
+      tflite::Flag::CreateFlag(kCacheDir, &cache_dir,
+                               "Directory for cached compiled partitions."),
+      tflite::Flag::CreateFlag(kCacheMaxSizeBytes,
+                               &options.cache_max_size_bytes,
+                               "Size limit of the cache directory in bytes."),
+      tflite::Flag::CreateFlag(kPrecompiledModelPath, &precompiled_model_path,
+                               "Container of precompiled partitions."),
+      tflite::Flag::CreateFlag(kMmapCompiledBlobs,
+                               &options.mmap_compiled_blobs,
+                               "Import compiled blobs from shared mappings."),
+      tflite::Flag::CreateFlag(kMaxConcurrentCompiles,
+                               &options.max_concurrent_compiles,
+                               "Partitions compiled at the same time."),
+      tflite::Flag::CreateFlag(kAsyncCompilation, &options.async_compilation,
+                               "Compile partitions in the background."),
+      tflite::Flag::CreateFlag(kTieredCompilation,
+                               &options.tiered_compilation,
+                               "Run on a fast CPU tier until compiled."),
+      tflite::Flag::CreateFlag(kZeroCopy, &options.zero_copy,
+                               "Bind tensor buffers instead of copying."),
+      tflite::Flag::CreateFlag(kNumInferRequests, &options.num_infer_requests,
+                               "Infer requests per partition, 0 for optimal."),
+      tflite::Flag::CreateFlag(kAsyncInference, &options.async_inference,
+                               "Return from Invoke once inference started."),
+      tflite::Flag::CreateFlag(kDynamicShapes, &options.dynamic_shapes,
+                               "Resize inputs without recompiling."),
+      tflite::Flag::CreateFlag(kShapeBuckets, &shape_buckets,
+                               "Lengths to pad a variable input axis to."),
+      tflite::Flag::CreateFlag(kBucketAxis, &options.bucket_axis,
+                               "Input axis padded to the shape buckets."),
+      tflite::Flag::CreateFlag(kMaxBatchSize, &options.max_batch_size,
+                               "Invocations batched together, 0 for none."),
+      tflite::Flag::CreateFlag(kBatchTimeoutUs, &options.batch_timeout_us,
+                               "Longest wait for a batch to fill."),
+      tflite::Flag::CreateFlag(kPreprocessing, &preprocessing,
+                               "KEY=VALUE;... raw frame preprocessing."),
+      tflite::Flag::CreateFlag(kStaticInputs, &static_inputs,
+                               "Inputs copied only when changed."),
+      tflite::Flag::CreateFlag(kShareModelWeights,
+                               &options.share_model_weights,
+                               "Build constants over the model weights."),
+      tflite::Flag::CreateFlag(kReleaseModels, &options.release_models,
+                               "Free partition models once compiled."),
+      tflite::Flag::CreateFlag(kRecordReleaseStats,
+                               &options.record_release_stats,
+                               "Sample resident memory per release."),
   };
 
   if (!tflite::Flags::Parse(&argc, argv.data(), flag_list)) {
@@ -48,10 +134,51 @@ TfLiteDelegate *CreateOVDelegateFromOptions(const char *const *options_keys,
 
   TFLITE_LOG(INFO) << "OpenVINO delegate: debug_level set to "
                    << options.debug_level << ".";
-  /* TFLITE_LOG(INFO) << "OpenVINO delegate: plugins_path set to "
-                   << options.plugins_path << ".";
-  TFLITE_LOG(INFO) << "OpenVINO delegate: device_type set to "
-                   << options.device_type << "."; */
+  if (!plugins_path.empty()) {
+    options.plugins_path = plugins_path.c_str();
+    TFLITE_LOG(INFO) << "OpenVINO delegate: plugins_path set to "
+                     << plugins_path << ".";
+  }
+  if (!device_type.empty()) {
+    options.device_type = device_type.c_str();
+    TFLITE_LOG(INFO) << "OpenVINO delegate: device_type set to "
+                     << device_type << ".";
+  }
+  if (!performance_hint.empty()) {
+    options.performance_hint = performance_hint.c_str();
+    TFLITE_LOG(INFO) << "OpenVINO delegate: performance_hint set to "
+                     << performance_hint << ".";
+  }
+  if (!properties.empty()) {
+    options.properties = properties.c_str();
+    TFLITE_LOG(INFO) << "OpenVINO delegate: properties set to " << properties
+                     << ".";
+  }
+  if (!cache_dir.empty()) {
+    options.cache_dir = cache_dir.c_str();
+    TFLITE_LOG(INFO) << "OpenVINO delegate: cache_dir set to " << cache_dir
+                     << ".";
+  }
+  if (!precompiled_model_path.empty()) {
+    options.precompiled_model_path = precompiled_model_path.c_str();
+    TFLITE_LOG(INFO) << "OpenVINO delegate: precompiled_model_path set to "
+                     << precompiled_model_path << ".";
+  }
+  if (!shape_buckets.empty()) {
+    options.shape_buckets = shape_buckets.c_str();
+    TFLITE_LOG(INFO) << "OpenVINO delegate: shape_buckets set to "
+                     << shape_buckets << ".";
+  }
+  if (!preprocessing.empty()) {
+    options.preprocessing = preprocessing.c_str();
+    TFLITE_LOG(INFO) << "OpenVINO delegate: preprocessing set to "
+                     << preprocessing << ".";
+  }
+  if (!static_inputs.empty()) {
+    options.static_inputs = static_inputs.c_str();
+    TFLITE_LOG(INFO) << "OpenVINO delegate: static_inputs set to "
+                     << static_inputs << ".";
+  }
 
   return TfLiteCreateOpenVINODelegate(&options);
 }
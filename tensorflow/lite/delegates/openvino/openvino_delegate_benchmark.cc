@@ -0,0 +1,479 @@
+// Copyright (C) 2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+// Measurements of the OpenVINO delegate that benchmark_model does not cover.
+//
+//   --mode=rss   Forks 1, 2, 4, ... up to --max_workers processes that load
+//                the same model concurrently and reports their memory
+//                footprint. Run it once with and once without
+//                --mmap_compiled_blobs on a --precompiled_model_path to see
+//                how much of the compiled model is shared between workers,
+//                and once with and once without --share_model_weights to see
+//                the peak memory of initialization drop by the weights that
+//                are no longer copied.
+//                --release_models=false shows the steady-state memory the
+//                models would hold after compilation.
+//   --mode=startup
+//                Creates --num_runs delegated interpreters one after another
+//                in the same process and reports the time each one takes to
+//                initialize and to run once. Only the first one pays for
+//                plugin loading and device discovery, the others reuse the
+//                process-wide core. Compare --max_concurrent_compiles=1 with
+//                the default on a model split into several partitions to see
+//                the effect of compiling them in parallel, and add
+//                --async_compilation to move compilation from the
+//                initialization to the first run, or --tiered_compilation to
+//                run on a fast CPU tier until the target device is ready.
+//                Also reports the constants built per run and how much of
+//                them reused identical constants.
+//   --mode=latency
+//                Reports the average latency of --num_invokes invocations of
+//                each model of a comma-separated --graph list, once copying
+//                inputs and outputs and once binding them with zero_copy. Use
+//                models of increasing tensor sizes to see what copies cost.
+//   --mode=throughput
+//                Applies one delegate to --num_threads interpreters and
+//                reports the inferences per second of as many threads each
+//                invoking its own interpreter --num_invokes times. Combine
+//                with --performance_hint=THROUGHPUT; the interpreters share
+//                the compiled partitions and their --num_infer_requests.
+//                With --max_batch_size, concurrent invocations are batched
+//                and the occupancy and latency of the batches is reported.
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "openvino_delegate.h"
+#include "tensorflow/lite/c/c_api.h"
+#include "tensorflow/lite/tools/command_line_flags.h"
+#include "tensorflow/lite/tools/logging.h"
+
+namespace {
+
+struct BenchmarkParams {
+  std::string graph;
+  std::string mode = "rss";
+  int max_workers = 16;
+  int num_runs = 4;
+  int num_invokes = 100;
+  int num_threads = 4;
+  std::string device_type;
+  std::string performance_hint;
+  int num_streams = 0;
+  int inference_num_threads = 0;
+  std::string properties;
+  std::string cache_dir;
+  std::string precompiled_model_path;
+  bool mmap_compiled_blobs = false;
+  int max_concurrent_compiles = 0;
+  bool async_compilation = false;
+  bool tiered_compilation = false;
+  bool zero_copy = true;
+  int num_infer_requests = 0;
+  int max_batch_size = 0;
+  int batch_timeout_us = 1000;
+  bool share_model_weights = false;
+  bool release_models = true;
+  bool record_release_stats = false;
+};
+
+struct MemoryUsage {
+  int64_t rss_kb = 0;
+  int64_t peak_rss_kb = 0;
+  int64_t pss_kb = 0;
+  int64_t private_kb = 0;
+};
+
+int64_t ReadProcValue(const char *path, const std::string &field) {
+  std::ifstream file(path);
+  std::string line;
+  int64_t total = 0;
+  while (std::getline(file, line)) {
+    if (line.compare(0, field.size(), field) != 0) continue;
+    std::istringstream value(line.substr(field.size()));
+    int64_t kb = 0;
+    value >> kb;
+    total += kb;
+  }
+  return total;
+}
+
+MemoryUsage GetMemoryUsage() {
+  MemoryUsage usage;
+  usage.rss_kb = ReadProcValue("/proc/self/status", "VmRSS:");
+  usage.peak_rss_kb = ReadProcValue("/proc/self/status", "VmHWM:");
+  usage.pss_kb = ReadProcValue("/proc/self/smaps_rollup", "Pss:");
+  usage.private_kb =
+      ReadProcValue("/proc/self/smaps_rollup", "Private_Clean:") +
+      ReadProcValue("/proc/self/smaps_rollup", "Private_Dirty:");
+  return usage;
+}
+
+TfLiteOpenVINODelegateOptions GetDelegateOptions(
+    const BenchmarkParams &params) {
+  TfLiteOpenVINODelegateOptions options =
+      TfLiteOpenVINODelegateOptionsDefault();
+  if (!params.device_type.empty())
+    options.device_type = params.device_type.c_str();
+  if (!params.performance_hint.empty())
+    options.performance_hint = params.performance_hint.c_str();
+  options.num_streams = params.num_streams;
+  options.inference_num_threads = params.inference_num_threads;
+  if (!params.properties.empty())
+    options.properties = params.properties.c_str();
+  if (!params.cache_dir.empty()) options.cache_dir = params.cache_dir.c_str();
+  if (!params.precompiled_model_path.empty())
+    options.precompiled_model_path = params.precompiled_model_path.c_str();
+  options.mmap_compiled_blobs = params.mmap_compiled_blobs;
+  options.max_concurrent_compiles = params.max_concurrent_compiles;
+  options.async_compilation = params.async_compilation;
+  options.tiered_compilation = params.tiered_compilation;
+  options.zero_copy = params.zero_copy;
+  options.num_infer_requests = params.num_infer_requests;
+  options.max_batch_size = params.max_batch_size;
+  options.batch_timeout_us = params.batch_timeout_us;
+  options.share_model_weights = params.share_model_weights;
+  options.release_models = params.release_models;
+  options.record_release_stats = params.record_release_stats;
+  return options;
+}
+
+// Creates a delegated interpreter and allocates its tensors. Returns false on
+// error.
+bool Load(const BenchmarkParams &params, TfLiteModel **model,
+          TfLiteOpaqueDelegate **delegate, TfLiteInterpreter **interpreter) {
+  *model = TfLiteModelCreateFromFile(params.graph.c_str());
+  if (*model == nullptr) return false;
+  TfLiteOpenVINODelegateOptions delegate_options = GetDelegateOptions(params);
+  *delegate = TfLiteCreateOpenVINODelegate(&delegate_options);
+  TfLiteInterpreterOptions *options = TfLiteInterpreterOptionsCreate();
+  TfLiteInterpreterOptionsAddDelegate(options, *delegate);
+  *interpreter = TfLiteInterpreterCreate(*model, options);
+  TfLiteInterpreterOptionsDelete(options);
+  return *interpreter != nullptr &&
+         TfLiteInterpreterAllocateTensors(*interpreter) == kTfLiteOk;
+}
+
+// Loads the model with the delegate and runs it once. Returns false on error.
+bool LoadAndInvoke(const BenchmarkParams &params, TfLiteModel **model,
+                   TfLiteOpaqueDelegate **delegate,
+                   TfLiteInterpreter **interpreter) {
+  return Load(params, model, delegate, interpreter) &&
+         TfLiteInterpreterInvoke(*interpreter) == kTfLiteOk;
+}
+
+// Runs num_workers processes that each hold a delegated interpreter. All of
+// them are measured only once every worker finished loading, so that shared
+// pages are accounted to all of them.
+bool MeasureWorkers(const BenchmarkParams &params, int num_workers,
+                    std::vector<MemoryUsage> &usages) {
+  int ready_pipe[2], go_pipe[2], result_pipe[2];
+  if (pipe(ready_pipe) || pipe(go_pipe) || pipe(result_pipe)) return false;
+
+  std::vector<pid_t> workers;
+  for (int i = 0; i < num_workers; i++) {
+    pid_t pid = fork();
+    if (pid == 0) {
+      close(go_pipe[1]);
+      TfLiteModel *model = nullptr;
+      TfLiteOpaqueDelegate *delegate = nullptr;
+      TfLiteInterpreter *interpreter = nullptr;
+      char status = LoadAndInvoke(params, &model, &delegate, &interpreter);
+      write(ready_pipe[1], &status, 1);
+      char go;
+      read(go_pipe[0], &go, 1);
+      MemoryUsage usage = GetMemoryUsage();
+      write(result_pipe[1], &usage, sizeof(usage));
+      _exit(status ? 0 : 1);
+    }
+    workers.push_back(pid);
+  }
+
+  bool success = true;
+  for (int i = 0; i < num_workers; i++) {
+    char status = 0;
+    if (read(ready_pipe[0], &status, 1) != 1 || !status) success = false;
+  }
+  close(go_pipe[1]);
+  for (int i = 0; i < num_workers; i++) {
+    MemoryUsage usage;
+    if (read(result_pipe[0], &usage, sizeof(usage)) == sizeof(usage))
+      usages.push_back(usage);
+  }
+  for (pid_t pid : workers) waitpid(pid, nullptr, 0);
+  for (int fd : {ready_pipe[0], ready_pipe[1], go_pipe[0], result_pipe[0],
+                 result_pipe[1]})
+    close(fd);
+  return success && usages.size() == num_workers;
+}
+
+int RunRssBenchmark(const BenchmarkParams &params) {
+  printf("%8s %14s %14s %14s %14s %16s\n", "workers", "avg_rss_kb",
+         "avg_peak_rss_kb", "avg_pss_kb", "avg_private_kb", "total_pss_kb");
+  for (int workers = 1; workers <= params.max_workers; workers *= 2) {
+    std::vector<MemoryUsage> usages;
+    if (!MeasureWorkers(params, workers, usages)) {
+      TFLITE_LOG(ERROR) << "Failed to run " << workers << " workers\n";
+      return 1;
+    }
+    MemoryUsage total;
+    for (const MemoryUsage &usage : usages) {
+      total.rss_kb += usage.rss_kb;
+      total.peak_rss_kb += usage.peak_rss_kb;
+      total.pss_kb += usage.pss_kb;
+      total.private_kb += usage.private_kb;
+    }
+    printf("%8d %14lld %14lld %14lld %14lld %16lld\n", workers,
+           (long long)(total.rss_kb / workers),
+           (long long)(total.peak_rss_kb / workers),
+           (long long)(total.pss_kb / workers),
+           (long long)(total.private_kb / workers), (long long)total.pss_kb);
+  }
+  return 0;
+}
+
+int RunStartupBenchmark(const BenchmarkParams &params) {
+  struct Run {
+    TfLiteModel *model = nullptr;
+    TfLiteOpaqueDelegate *delegate = nullptr;
+    TfLiteInterpreter *interpreter = nullptr;
+  };
+  // Every interpreter stays alive until the end, as in a process serving
+  // several models or several interpreters of one model.
+  std::vector<Run> runs(params.num_runs);
+  printf("%8s %14s %18s %14s %18s\n", "run", "init_ms", "first_invoke_ms",
+         "constant_kb", "deduplicated_kb");
+  int result = 0;
+  for (int i = 0; i < params.num_runs; i++) {
+    auto start = std::chrono::steady_clock::now();
+    if (!Load(params, &runs[i].model, &runs[i].delegate,
+              &runs[i].interpreter)) {
+      TFLITE_LOG(ERROR) << "Failed to initialize run " << i << "\n";
+      result = 1;
+      break;
+    }
+    auto loaded = std::chrono::steady_clock::now();
+    if (TfLiteInterpreterInvoke(runs[i].interpreter) != kTfLiteOk) {
+      TFLITE_LOG(ERROR) << "Failed to invoke run " << i << "\n";
+      result = 1;
+      break;
+    }
+    auto invoked = std::chrono::steady_clock::now();
+    uint64_t constant_bytes = 0, deduplicated_bytes = 0;
+    TfLiteOpenVINODelegateGetConstantStats(runs[i].delegate, &constant_bytes,
+                                           &deduplicated_bytes);
+    printf("%8d %14.2f %18.2f %14llu %18llu\n", i,
+           std::chrono::duration<double, std::milli>(loaded - start).count(),
+           std::chrono::duration<double, std::milli>(invoked - loaded).count(),
+           static_cast<unsigned long long>(constant_bytes / 1024),
+           static_cast<unsigned long long>(deduplicated_bytes / 1024));
+  }
+  for (Run &run : runs) {
+    if (run.interpreter != nullptr) TfLiteInterpreterDelete(run.interpreter);
+    if (run.model != nullptr) TfLiteModelDelete(run.model);
+  }
+  return result;
+}
+
+// Average latency in microseconds of params.num_invokes invocations, -1 on
+// error. input_bytes receives the total size of the model inputs.
+double MeasureInvokeLatency(const BenchmarkParams &params,
+                            size_t &input_bytes) {
+  TfLiteModel *model = nullptr;
+  TfLiteOpaqueDelegate *delegate = nullptr;
+  TfLiteInterpreter *interpreter = nullptr;
+  double latency = -1;
+  // The first invocation also waits for background compilations.
+  if (LoadAndInvoke(params, &model, &delegate, &interpreter)) {
+    input_bytes = 0;
+    for (int i = 0; i < TfLiteInterpreterGetInputTensorCount(interpreter); i++)
+      input_bytes += TfLiteTensorByteSize(
+          TfLiteInterpreterGetInputTensor(interpreter, i));
+    auto start = std::chrono::steady_clock::now();
+    bool success = true;
+    for (int i = 0; i < params.num_invokes && success; i++)
+      success = TfLiteInterpreterInvoke(interpreter) == kTfLiteOk;
+    auto elapsed = std::chrono::duration<double, std::micro>(
+        std::chrono::steady_clock::now() - start);
+    if (success) latency = elapsed.count() / std::max(1, params.num_invokes);
+  }
+  if (interpreter != nullptr) TfLiteInterpreterDelete(interpreter);
+  if (model != nullptr) TfLiteModelDelete(model);
+  return latency;
+}
+
+int RunLatencyBenchmark(const BenchmarkParams &params) {
+  printf("%-40s %14s %14s %16s\n", "graph", "input_bytes", "copy_us",
+         "zero_copy_us");
+  std::istringstream graphs(params.graph);
+  std::string graph;
+  while (std::getline(graphs, graph, ',')) {
+    BenchmarkParams run_params = params;
+    run_params.graph = graph;
+    size_t input_bytes = 0;
+    run_params.zero_copy = false;
+    double copy_us = MeasureInvokeLatency(run_params, input_bytes);
+    run_params.zero_copy = true;
+    double zero_copy_us = MeasureInvokeLatency(run_params, input_bytes);
+    if (copy_us < 0 || zero_copy_us < 0) {
+      TFLITE_LOG(ERROR) << "Failed to run " << graph << "\n";
+      return 1;
+    }
+    printf("%-40s %14zu %14.1f %16.1f\n", graph.c_str(), input_bytes, copy_us,
+           zero_copy_us);
+  }
+  return 0;
+}
+
+int RunThroughputBenchmark(const BenchmarkParams &params) {
+  TfLiteModel *model = TfLiteModelCreateFromFile(params.graph.c_str());
+  if (model == nullptr) return 1;
+  TfLiteOpenVINODelegateOptions delegate_options = GetDelegateOptions(params);
+  TfLiteOpaqueDelegate *delegate =
+      TfLiteCreateOpenVINODelegate(&delegate_options);
+  TfLiteInterpreterOptions *options = TfLiteInterpreterOptionsCreate();
+  TfLiteInterpreterOptionsAddDelegate(options, delegate);
+
+  // Created and run once up front, so that only inference is measured.
+  std::vector<TfLiteInterpreter *> interpreters;
+  bool success = true;
+  for (int i = 0; i < params.num_threads && success; i++) {
+    TfLiteInterpreter *interpreter = TfLiteInterpreterCreate(model, options);
+    success = interpreter != nullptr &&
+              TfLiteInterpreterAllocateTensors(interpreter) == kTfLiteOk &&
+              TfLiteInterpreterInvoke(interpreter) == kTfLiteOk;
+    if (interpreter != nullptr) interpreters.push_back(interpreter);
+  }
+  TfLiteInterpreterOptionsDelete(options);
+
+  if (success) {
+    std::vector<char> results(interpreters.size(), true);
+    std::vector<std::thread> threads;
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < interpreters.size(); i++) {
+      threads.emplace_back([&, i] {
+        for (int n = 0; n < params.num_invokes && results[i]; n++)
+          results[i] = TfLiteInterpreterInvoke(interpreters[i]) == kTfLiteOk;
+      });
+    }
+    for (std::thread &thread : threads) thread.join();
+    auto elapsed = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - start);
+    success = std::all_of(results.begin(), results.end(),
+                          [](char result) { return result; });
+    if (success) {
+      printf("%10s %14s %14s\n", "threads", "inferences", "per_second");
+      const int inferences = params.num_threads * params.num_invokes;
+      printf("%10d %14d %14.1f\n", params.num_threads, inferences,
+             inferences / elapsed.count());
+    }
+    uint64_t batches = 0, requests = 0;
+    int64_t wait_us = 0, latency_us = 0;
+    if (success && params.max_batch_size > 1 &&
+        TfLiteOpenVINODelegateGetBatchStats(delegate, &batches, &requests,
+                                            &wait_us, &latency_us) ==
+            kTfLiteOk &&
+        batches != 0) {
+      printf("%10s %14s %14s %14s\n", "batches", "occupancy", "wait_us",
+             "latency_us");
+      printf("%10llu %14.2f %14lld %14lld\n",
+             static_cast<unsigned long long>(batches),
+             static_cast<double>(requests) /
+                 (batches * params.max_batch_size),
+             static_cast<long long>(wait_us),
+             static_cast<long long>(latency_us));
+    }
+  }
+  if (!success) TFLITE_LOG(ERROR) << "Failed to run " << params.graph << "\n";
+
+  for (TfLiteInterpreter *interpreter : interpreters)
+    TfLiteInterpreterDelete(interpreter);
+  TfLiteModelDelete(model);
+  return success ? 0 : 1;
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  BenchmarkParams params;
+  std::vector<tflite::Flag> flag_list = {
+      tflite::Flag::CreateFlag("graph", &params.graph, "Path to the model."),
+      tflite::Flag::CreateFlag("mode", &params.mode,
+                               "rss, startup, latency or throughput."),
+      tflite::Flag::CreateFlag("max_workers", &params.max_workers,
+                               "Largest number of worker processes."),
+      tflite::Flag::CreateFlag("num_runs", &params.num_runs,
+                               "Number of interpreters to create."),
+      tflite::Flag::CreateFlag("num_invokes", &params.num_invokes,
+                               "Invocations measured per model."),
+      tflite::Flag::CreateFlag("num_threads", &params.num_threads,
+                               "Interpreters invoked concurrently."),
+      tflite::Flag::CreateFlag("device_type", &params.device_type,
+                               "OpenVINO device."),
+      tflite::Flag::CreateFlag("performance_hint", &params.performance_hint,
+                               "LATENCY, THROUGHPUT or CUMULATIVE_THROUGHPUT."),
+      tflite::Flag::CreateFlag("num_streams", &params.num_streams,
+                               "Number of streams, -1 for AUTO."),
+      tflite::Flag::CreateFlag("inference_num_threads",
+                               &params.inference_num_threads,
+                               "Number of inference threads."),
+      tflite::Flag::CreateFlag("properties", &params.properties,
+                               "KEY=VALUE;... compile_model properties."),
+      tflite::Flag::CreateFlag("cache_dir", &params.cache_dir,
+                               "Compiled-model cache directory."),
+      tflite::Flag::CreateFlag("precompiled_model_path",
+                               &params.precompiled_model_path,
+                               "Container of precompiled partitions."),
+      tflite::Flag::CreateFlag("mmap_compiled_blobs",
+                               &params.mmap_compiled_blobs,
+                               "Import compiled blobs from shared mappings."),
+      tflite::Flag::CreateFlag("max_concurrent_compiles",
+                               &params.max_concurrent_compiles,
+                               "Partitions compiled at the same time."),
+      tflite::Flag::CreateFlag("async_compilation", &params.async_compilation,
+                               "Compile partitions in the background."),
+      tflite::Flag::CreateFlag("tiered_compilation",
+                               &params.tiered_compilation,
+                               "Run on a fast CPU tier until compiled."),
+      tflite::Flag::CreateFlag("zero_copy", &params.zero_copy,
+                               "Bind tensor buffers instead of copying."),
+      tflite::Flag::CreateFlag("num_infer_requests",
+                               &params.num_infer_requests,
+                               "Infer requests per partition, 0 for optimal."),
+      tflite::Flag::CreateFlag("max_batch_size", &params.max_batch_size,
+                               "Invocations batched together, 0 for none."),
+      tflite::Flag::CreateFlag("batch_timeout_us", &params.batch_timeout_us,
+                               "Longest wait for a batch to fill."),
+      tflite::Flag::CreateFlag("share_model_weights",
+                               &params.share_model_weights,
+                               "Build constants over the model weights."),
+      tflite::Flag::CreateFlag("release_models", &params.release_models,
+                               "Free partition models once compiled."),
+      tflite::Flag::CreateFlag("record_release_stats",
+                               &params.record_release_stats,
+                               "Sample resident memory per release."),
+  };
+  if (!tflite::Flags::Parse(&argc, const_cast<const char **>(argv),
+                            flag_list) ||
+      params.graph.empty()) {
+    TFLITE_LOG(ERROR) << tflite::Flags::Usage(argv[0], flag_list);
+    return 1;
+  }
+
+  if (params.mode == "rss") return RunRssBenchmark(params);
+  if (params.mode == "startup") return RunStartupBenchmark(params);
+  if (params.mode == "latency") return RunLatencyBenchmark(params);
+  if (params.mode == "throughput") return RunThroughputBenchmark(params);
+  TFLITE_LOG(ERROR) << "Unknown mode " << params.mode << "\n";
+  return 1;
+}
@@ -4,22 +4,197 @@
 
 #include "openvino_delegate_core.h"
 
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <map>
+#include <string>
+
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
+#include "tensorflow/lite/tools/logging.h"
+
 namespace tflite {
 namespace openvinodelegate {
+namespace {
 
-TfLiteStatus OpenVINODelegateCore::CreateGraphfromTfLite(
+bool SameShape(const ov::Shape &shape, const TfLiteOpaqueTensor *tensor) {
+  const int32_t num_dims = TfLiteOpaqueTensorNumDims(tensor);
+  if (shape.size() != static_cast<size_t>(num_dims)) return false;
+  for (int32_t i = 0; i < num_dims; i++) {
+    if (shape[i] != static_cast<size_t>(TfLiteOpaqueTensorDim(tensor, i)))
+      return false;
+  }
+  return true;
+}
+
+ov::Shape GetShape(const TfLiteOpaqueTensor *tensor) {
+  ov::Shape shape(TfLiteOpaqueTensorNumDims(tensor));
+  for (size_t i = 0; i < shape.size(); i++)
+    shape[i] = TfLiteOpaqueTensorDim(tensor, i);
+  return shape;
+}
+
+// Splits tensor into outer rows of items along axis, each of item_bytes
+// bytes, for padding into or cropping from padded. Fails unless both only
+// differ at axis, where tensor may be shorter.
+bool GetRows(const TfLiteOpaqueTensor *tensor, const ov::Shape &padded,
+             int axis, size_t element_size, size_t &outer,
+             size_t &item_bytes) {
+  if (static_cast<size_t>(axis) >= padded.size() ||
+      padded.size() != static_cast<size_t>(TfLiteOpaqueTensorNumDims(tensor)))
+    return false;
+  outer = 1;
+  item_bytes = element_size;
+  for (size_t i = 0; i < padded.size(); i++) {
+    const size_t dim = TfLiteOpaqueTensorDim(tensor, i);
+    if (i == static_cast<size_t>(axis)) {
+      if (dim > padded[i]) return false;
+    } else if (dim != padded[i]) {
+      return false;
+    } else if (i < static_cast<size_t>(axis)) {
+      outer *= dim;
+    } else {
+      item_bytes *= dim;
+    }
+  }
+  return true;
+}
+
+// Resident memory of the process in bytes, 0 where /proc is unavailable.
+int64_t GetResidentBytes() {
+  std::ifstream statm("/proc/self/statm");
+  int64_t size = 0, resident = 0;
+  if (!(statm >> size >> resident)) return 0;
+  return resident * sysconf(_SC_PAGESIZE);
+}
+
+// Stacks the rows of count requests into the single request of
+// infer_requests, runs it and scatters the output rows back.
+TfLiteStatus RunBatch(OpenVINOInferRequestPool &infer_requests,
+                      const std::vector<size_t> &input_rows,
+                      const std::vector<size_t> &output_rows,
+                      OpenVINORequestBatcher::Request *const *requests,
+                      size_t count) {
+  size_t index = 0;
+  OpenVINOInferRequestPool::Slot *slot = infer_requests.Acquire(index);
+  if (slot == nullptr) return kTfLiteError;
+  for (size_t i = 0; i < input_rows.size(); i++) {
+    uint8_t *rows = static_cast<uint8_t *>(slot->inputs[i].tensor.data());
+    for (size_t k = 0; k < count; k++)
+      std::memcpy(rows + k * input_rows[i], requests[k]->inputs[i],
+                  input_rows[i]);
+  }
+  TfLiteStatus status = kTfLiteOk;
+  try {
+    // Rows past count hold stale inputs, their outputs are dropped.
+    slot->request.infer();
+  } catch (const std::exception &e) {
+    TFLITE_LOG(ERROR) << "Batched inference failed: " << e.what() << "\n";
+    status = kTfLiteError;
+  }
+  for (size_t o = 0; o < output_rows.size() && status == kTfLiteOk; o++) {
+    const uint8_t *rows =
+        static_cast<const uint8_t *>(slot->outputs[o].tensor.data());
+    for (size_t k = 0; k < count; k++)
+      std::memcpy(requests[k]->outputs[o], rows + k * output_rows[o],
+                  output_rows[o]);
+  }
+  infer_requests.Release(index);
+  return status;
+}
+
+}  // namespace
+
+TfLiteStatus OpenVINODelegateCore::OpenVINODelegateInit() {
+  // Virtual devices such as AUTO, HETERO or MULTI are resolved by OpenVINO
+  // at compile time.
+  if (ov_device_.find(':') != std::string::npos || ov_device_ == "AUTO")
+    return kTfLiteOk;
+  for (const std::string &device : shared_core_->getAvailableDevices()) {
+    // Devices with several instances are enumerated as GPU.0, GPU.1, ...
+    if (device == ov_device_ || device.rfind(ov_device_ + ".", 0) == 0)
+      return kTfLiteOk;
+  }
+  TFLITE_LOG(ERROR) << "OpenVINO device " << ov_device_
+                    << " is not available\n";
+  return kTfLiteDelegateError;
+}
+
+TfLiteStatus OpenVINODelegateCore::CollectComputeInputs(
     TfLiteOpaqueContext *context, const TfLiteOpaqueDelegateParams *params) {
-  if (context == nullptr || params == nullptr) return kTfLiteError;
   const std::unordered_set<int> inputs(
       &params->input_tensors->data[0],
       &params->input_tensors->data[params->input_tensors->size]);
 
-  openvino_graph_builder_ =
-      std::make_unique<OpenVINOGraphBuilder>(std::make_unique<NodeManager>());
+  compute_inputs_.clear();
+  input_shapes_.clear();
+  preprocessed_.clear();
+  marks_seen_.clear();
+  for (int i = 0; i < params->nodes_to_replace->size; i++) {
+    const int delegate_node_id = params->nodes_to_replace->data[i];
+    TfLiteOpaqueNode *delegate_node;
+    TfLiteRegistrationExternal *delegate_node_registration;
+    if (TfLiteOpaqueContextGetNodeAndRegistration(context, delegate_node_id,
+                                                  &delegate_node,
+                                                  &delegate_node_registration))
+      return kTfLiteError;
 
-  for (int o = 0; o < params->output_tensors->size; o++) {
-    const int output_tensor_idx = params->output_tensors->data[o];
-    outputs_.push_back(output_tensor_idx);
+    const int *inputs_data = nullptr;
+    int num_inputs = 0;
+    if (TfLiteOpaqueNodeInputs(delegate_node, &inputs_data, &num_inputs) !=
+        kTfLiteOk)
+      return kTfLiteError;
+    for (int k = 0; k < num_inputs; k++) {
+      if (TfLiteRegistrationExternalGetBuiltInCode(
+              delegate_node_registration) == kTfLiteBuiltinTransposeConv &&
+          k == 0) {
+        continue;
+      }
+      const int t = inputs_data[k];
+      if (inputs.count(t) == 0) continue;
+      auto opaque_tensor = TfLiteOpaqueContextGetOpaqueTensor(context, t);
+      if (TfLiteOpaqueTensorGetAllocationType(opaque_tensor) == kTfLiteMmapRo)
+        continue;
+      // A partition input consumed by several nodes maps to one Parameter.
+      if (std::find(compute_inputs_.begin(), compute_inputs_.end(), t) ==
+          compute_inputs_.end()) {
+        compute_inputs_.push_back(t);
+        ov::PartialShape shape = OpenVINOGraphBuilder::GetInputShape(
+            opaque_tensor, dynamic_shapes_);
+        if (shape_buckets_ != nullptr &&
+            shape.rank().get_length() > shape_buckets_->getAxis())
+          shape[shape_buckets_->getAxis()] = ov::Dimension::dynamic();
+        input_shapes_.push_back(shape);
+        preprocessed_.push_back(
+            preprocessing_ != nullptr && preprocessing_->AppliesTo(t) &&
+            TfLiteOpaqueTensorNumDims(opaque_tensor) == 4 &&
+            TfLiteOpaqueTensorType(opaque_tensor) == kTfLiteFloat32);
+        marks_seen_.push_back(0);
+      }
+    }
+  }
+  return kTfLiteOk;
+}
+
+TfLiteStatus OpenVINODelegateCore::BuildModel(
+    TfLiteOpaqueContext *context, const TfLiteOpaqueDelegateParams *params) {
+  openvino_graph_builder_ = std::make_unique<OpenVINOGraphBuilder>(
+      std::make_unique<NodeManager>(), share_constants_);
+
+  for (int t : compute_inputs_) {
+    auto opaque_tensor = TfLiteOpaqueContextGetOpaqueTensor(context, t);
+    // Bucketed models are reshaped before they are compiled.
+    if (openvino_graph_builder_->AddInputParams(
+            opaque_tensor, t, dynamic_shapes_ || shape_buckets_ != nullptr) !=
+        kTfLiteOk)
+      return kTfLiteError;
   }
 
   for (int i = 0; i < params->nodes_to_replace->size; i++) {
@@ -44,22 +219,12 @@ TfLiteStatus OpenVINODelegateCore::CreateGraphfromTfLite(
           kTfLiteOk)
         return kTfLiteError;
       const int t = inputs_data[k];
-      const void *data = nullptr;
       auto opaque_tensor = TfLiteOpaqueContextGetOpaqueTensor(context, t);
       auto allocation_type = TfLiteOpaqueTensorGetAllocationType(opaque_tensor);
       if (allocation_type == kTfLiteMmapRo) {
-        data = TfLiteOpaqueTensorData(opaque_tensor);
         if (openvino_graph_builder_->CreateConstNode(context, t) != kTfLiteOk)
           return kTfLiteError;
       }
-      if (inputs.count(t) != 0) {
-        if (data == nullptr) {
-          if (openvino_graph_builder_->AddInputParams(opaque_tensor, t) !=
-              kTfLiteOk)
-            return kTfLiteError;
-          compute_inputs_.push_back(t);
-        }
-      }
     }
     if (openvino_graph_builder_->CreateNodeFromTfLiteOp(
             delegate_node_id, delegate_node_registration, delegate_node,
@@ -67,21 +232,819 @@ TfLiteStatus OpenVINODelegateCore::CreateGraphfromTfLite(
       return kTfLiteError;
   }
 
-
   openvino_graph_builder_->UpdateResultNodes(context, outputs_);
-  std::shared_ptr<ov::Model> model =
+  if (compiled_partitions_ != nullptr)
+    compiled_partitions_->RecordConstants(
+        openvino_graph_builder_->getConstantBytes(),
+        openvino_graph_builder_->getDeduplicatedBytes());
+  model_ =
       std::make_shared<ov::Model>(openvino_graph_builder_->getResultNodes(),
                                   openvino_graph_builder_->getInputParams());
-  // TODO: get device string from flags
-  std::string deviceStr = "NPU";
-  if (model) {
-    ov::AnyMap config;
-    config["NPU_COMPILATION_MODE_PARAMS"] = "enable-se-ptrs-operations=true";
-    compiled_model_ =
-        openvino_delegate_core_.compile_model(model, deviceStr, config);
+  // Weight layout conversions are folded once here rather than by the
+  // plugin on every compile of the partition. Shared weights are left to the
+  // plugin, folding them would copy them into the model.
+  if (!share_constants_) {
+    ov::pass::Manager manager;
+    manager.register_pass<ov::pass::ConstantFolding>();
+    manager.run_passes(model_);
+  }
+
+  std::vector<size_t> preprocessed;
+  for (size_t i = 0; i < preprocessed_.size(); i++)
+    if (preprocessed_[i]) preprocessed.push_back(i);
+  if (!preprocessed.empty()) {
+    try {
+      model_ = preprocessing_->Apply(model_, preprocessed);
+    } catch (const std::exception &e) {
+      TFLITE_LOG(ERROR) << "Unable to preprocess the inputs: " << e.what()
+                        << "\n";
+      return kTfLiteError;
+    }
+  }
+  return kTfLiteOk;
+}
+
+TfLiteStatus OpenVINODelegateCore::CollectPartition(
+    TfLiteOpaqueContext *context, const TfLiteOpaqueDelegateParams *params) {
+  if (context == nullptr || params == nullptr) return kTfLiteError;
+
+  outputs_.clear();
+  for (int o = 0; o < params->output_tensors->size; o++) {
+    const int output_tensor_idx = params->output_tensors->data[o];
+    outputs_.push_back(output_tensor_idx);
+  }
+
+  if (CollectComputeInputs(context, params) != kTfLiteOk) return kTfLiteError;
+
+  partition_key_.clear();
+  if (model_cache_ != nullptr || compiled_partitions_ != nullptr) {
+    ov::AnyMap properties = compile_properties_;
+    // Preprocessing is folded into the compiled model, key it like a
+    // property of its own.
+    if (std::find(preprocessed_.begin(), preprocessed_.end(), true) !=
+        preprocessed_.end())
+      properties["TFLITE_PREPROCESSING"] = preprocessing_->getSpec();
+    partition_key_ = OpenVINOModelCache::ComputeKey(context, params,
+                                                    ov_device_, properties);
+    // The same partition compiles to another model with dynamic inputs.
+    if (dynamic_shapes_) partition_key_ += "-dynamic";
+  }
+  return kTfLiteOk;
+}
+
+TfLiteStatus OpenVINODelegateCore::ImportPartition() {
+  if (partition_key_.empty()) return kTfLiteError;
+  ov::Core &core = shared_core_->getCore();
+  bool imported = compiled_partitions_ != nullptr &&
+                  compiled_partitions_->Import(partition_key_, core,
+                                               ov_device_, compiled_model_);
+  if (!imported && model_cache_ != nullptr)
+    imported = model_cache_->Load(partition_key_, core, ov_device_,
+                                  compiled_model_, &mapped_blob_);
+  if (!imported) return kTfLiteError;
+
+  if (compiled_partitions_ != nullptr)
+    compiled_partitions_->Register(partition_key_, compiled_model_);
+  return kTfLiteOk;
+}
+
+TfLiteStatus OpenVINODelegateCore::CompilePartition() {
+  if (!model_) return kTfLiteError;
+  try {
+    compiled_model_ = shared_core_->getCore().compile_model(
+        model_, ov_device_, compile_properties_);
+  } catch (const std::exception &e) {
+    TFLITE_LOG(ERROR) << "Unable to compile partition: " << e.what() << "\n";
+    return kTfLiteError;
+  }
+  if (model_cache_ != nullptr)
+    model_cache_->Store(partition_key_, compiled_model_);
+  if (compiled_partitions_ != nullptr)
+    compiled_partitions_->Register(partition_key_, compiled_model_);
+  return kTfLiteOk;
+}
+
+TfLiteStatus OpenVINODelegateCore::PreparePartition(
+    TfLiteOpaqueContext *context, const TfLiteOpaqueDelegateParams *params) {
+  if (CollectPartition(context, params) != kTfLiteOk) return kTfLiteError;
+  return BuildModelUnlessPrecompiled(context, params);
+}
+
+bool OpenVINODelegateCore::IsPrecompiled() {
+  return (compiled_partitions_ != nullptr &&
+          compiled_partitions_->HasPrecompiled(partition_key_)) ||
+         (model_cache_ != nullptr && model_cache_->Contains(partition_key_));
+}
+
+TfLiteStatus OpenVINODelegateCore::BuildModelUnlessPrecompiled(
+    TfLiteOpaqueContext *context, const TfLiteOpaqueDelegateParams *params) {
+  // A blob found now is only a hint, it may be corrupt, stale or evicted by
+  // the time it is read. It is imported while context is still at hand to
+  // build the model from if that fails.
+  imported_ = IsPrecompiled() && ImportPartition() == kTfLiteOk;
+  if (imported_) return kTfLiteOk;
+  return BuildModel(context, params);
+}
+
+OpenVINOCompiledPartitions::PreparedPartition
+OpenVINODelegateCore::CompilePreparedPartition() {
+  OpenVINOCompiledPartitions::PreparedPartition prepared;
+  prepared.compiled = imported_ || CompilePartition() == kTfLiteOk;
+  if (prepared.compiled) {
+    prepared.compiled_model = compiled_model_;
+    prepared.mapped_blob = mapped_blob_;
+    ReleaseModel();
+  }
+  if (compiled_partitions_ != nullptr) compiled_partitions_->EndPreparing();
+  return prepared;
+}
+
+void OpenVINODelegateCore::ReleaseModel() {
+  if (!release_models_ || shape_buckets_ != nullptr ||
+      (model_ == nullptr && openvino_graph_builder_ == nullptr))
+    return;
+  if (!record_release_stats_) {
+    openvino_graph_builder_.reset();
+    model_.reset();
+    if (compiled_partitions_ != nullptr) compiled_partitions_->MarkReleased();
+    return;
+  }
+  const int64_t resident_before = GetResidentBytes();
+  openvino_graph_builder_.reset();
+  model_.reset();
+#ifdef __GLIBC__
+  // Hands the freed constants back to the system rather than to the heap.
+  malloc_trim(0);
+#endif
+  const int64_t resident_after = GetResidentBytes();
+  TFLITE_LOG(INFO) << "Released the model of partition " << partition_key_
+                   << ", resident memory " << resident_before << " -> "
+                   << resident_after << " bytes\n";
+  if (compiled_partitions_ != nullptr)
+    compiled_partitions_->RecordRelease(
+        {partition_key_, resident_before, resident_after});
+}
+
+void OpenVINODelegateCore::SetCompiledModel(
+    const ov::CompiledModel &compiled_model, bool shared) {
+  infer_requests_ =
+      shared && compiled_partitions_ != nullptr && !partition_key_.empty()
+          ? compiled_partitions_->GetInferRequestPool(
+                partition_key_, compiled_model, num_infer_requests_)
+          : std::make_shared<OpenVINOInferRequestPool>(compiled_model,
+                                                       num_infer_requests_);
+  slot_index_ = 0;
+}
+
+bool OpenVINODelegateCore::CanBind(
+    const OpenVINOInferRequestPool::Binding &binding, const void *data,
+    size_t size) const {
+  return zero_copy_ && size == binding.tensor.get_byte_size() &&
+         reinterpret_cast<uintptr_t>(data) %
+                 binding.tensor.get_element_type().size() ==
+             0;
+}
+
+TfLiteStatus OpenVINODelegateCore::ReleaseSlot(TfLiteStatus status,
+                                               bool finished) {
+  infer_requests_->Release(slot_index_, finished);
+  slot_ = nullptr;
+  return status;
+}
+
+TfLiteStatus OpenVINODelegateCore::BindTensors(TfLiteOpaqueContext *context) {
+  WaitForStartedInference();
+  // Decided once per invocation, the application may set the callback
+  // concurrently.
+  async_invoke_ =
+      async_inference_ != nullptr && async_inference_->hasCallback();
+  if (shape_buckets_ != nullptr && SelectBucket(context) != kTfLiteOk)
+    return kTfLiteError;
+  if (infer_requests_ == nullptr) return kTfLiteError;
+  // Another interpreter may hold the request this kernel used last.
+  slot_ = infer_requests_->Acquire(slot_index_);
+  if (slot_ == nullptr) return kTfLiteError;
+
+  for (size_t i = 0; i < slot_->inputs.size(); i++) {
+    OpenVINOInferRequestPool::Binding &binding = slot_->inputs[i];
+    const TfLiteOpaqueTensor *tensor =
+        TfLiteOpaqueContextGetOpaqueTensor(context, compute_inputs_[i]);
+    void *data = TfLiteOpaqueTensorData(tensor);
+    size_t size = TfLiteOpaqueTensorByteSize(tensor);
+    if (data == nullptr) return ReleaseSlot(kTfLiteError);
+    if (preprocessed_[i]) {
+      // Frames larger than the float tensor need a custom allocation.
+      if (binding.tensor.get_byte_size() > size &&
+          TfLiteOpaqueTensorGetAllocationType(tensor) != kTfLiteCustom) {
+        TFLITE_LOG(ERROR) << "Input " << i << " holds " << size
+                          << " bytes, frames of "
+                          << binding.tensor.get_byte_size()
+                          << " bytes need a custom allocation\n";
+        return ReleaseSlot(kTfLiteError);
+      }
+      size = binding.tensor.get_byte_size();
+    }
+    // A mark only covers one invocation, whichever way the input is fed.
+    const bool marked = input_tracker_ != nullptr &&
+                        input_tracker_->TakeUnchanged(compute_inputs_[i],
+                                                      marks_seen_[i]);
+    if (dynamic_shapes_ && !SameShape(binding.shape, tensor)) {
+      // Resized since the request last ran, its own memory follows.
+      binding.shape = GetShape(tensor);
+      binding.tensor.set_shape(binding.shape);
+      slot_->request.set_input_tensor(i, binding.tensor);
+      binding.bound = nullptr;
+      binding.source = nullptr;
+    }
+    if (shape_buckets_ != nullptr && !SameShape(binding.shape, tensor)) {
+      size_t outer, item_bytes;
+      if (!GetRows(tensor, binding.shape, shape_buckets_->getAxis(),
+                   binding.tensor.get_element_type().size(), outer,
+                   item_bytes))
+        return ReleaseSlot(kTfLiteError);
+      if (binding.bound != nullptr) {
+        slot_->request.set_input_tensor(i, binding.tensor);
+        binding.bound = nullptr;
+      }
+      binding.source = nullptr;
+      OpenVINOShapeBuckets::Pad(
+          data, binding.tensor.data(), outer,
+          TfLiteOpaqueTensorDim(tensor, shape_buckets_->getAxis()),
+          binding.shape[shape_buckets_->getAxis()], item_bytes);
+      continue;
+    }
+    if (binding.bound == data) continue;
+
+    if (!async_invoke_ && CanBind(binding, data, size)) {
+      // The infer request only reads inputs, TFLite keeps the buffer writable.
+      slot_->request.set_input_tensor(
+          i, ov::Tensor(binding.tensor.get_element_type(),
+                        binding.tensor.get_shape(), data));
+      binding.bound = data;
+      continue;
+    }
+    if (binding.bound != nullptr) {
+      // Still bound to the previous TFLite buffer, copy into own memory.
+      slot_->request.set_input_tensor(i, binding.tensor);
+      binding.bound = nullptr;
+    }
+    if (size != binding.tensor.get_byte_size()) {
+      TFLITE_LOG(ERROR) << "Input " << i << " holds " << size
+                        << " bytes, the compiled model expects "
+                        << binding.tensor.get_byte_size() << "\n";
+      return ReleaseSlot(kTfLiteError);
+    }
+    CopyInput(binding, i, data, size, marked);
+  }
+
+  for (size_t o = 0; o < slot_->outputs.size(); o++) {
+    OpenVINOInferRequestPool::Binding &binding = slot_->outputs[o];
+    const TfLiteOpaqueTensor *tensor =
+        TfLiteOpaqueContextGetOpaqueTensor(context, outputs_[o]);
+    void *data = TfLiteOpaqueTensorData(tensor);
+    if (data == nullptr) return ReleaseSlot(kTfLiteError);
+    if (dynamic_shapes_ && !SameShape(binding.shape, tensor)) {
+      binding.shape = GetShape(tensor);
+      binding.tensor.set_shape(binding.shape);
+      slot_->request.set_output_tensor(o, binding.tensor);
+      binding.bound = nullptr;
+    }
+    if (shape_buckets_ != nullptr && !SameShape(binding.shape, tensor)) {
+      // Written to the request's own memory, cropped by WriteOutputs.
+      if (binding.bound != nullptr) {
+        slot_->request.set_output_tensor(o, binding.tensor);
+        binding.bound = nullptr;
+      }
+      continue;
+    }
+    if (binding.bound == data) continue;
+
+    if (CanBind(binding, data, TfLiteOpaqueTensorByteSize(tensor))) {
+      slot_->request.set_output_tensor(
+          o, ov::Tensor(binding.tensor.get_element_type(),
+                        binding.tensor.get_shape(), data));
+      binding.bound = data;
+    } else if (binding.bound != nullptr) {
+      // Stop writing into the previous TFLite buffer, it may be freed.
+      slot_->request.set_output_tensor(o, binding.tensor);
+      binding.bound = nullptr;
+    }
+  }
+  return kTfLiteOk;
+}
+
+void OpenVINODelegateCore::CopyInput(
+    OpenVINOInferRequestPool::Binding &binding, size_t index, const void *data,
+    size_t size, bool marked) {
+  if (input_tracker_ == nullptr) {
+    std::memcpy(binding.tensor.data(), data, size);
+    return;
+  }
+  // Another kernel may have copied its own buffer into the request since.
+  const bool copied = binding.source == data;
+  bool unchanged = copied && marked;
+  if (!unchanged && input_tracker_->IsStatic(compute_inputs_[index])) {
+    const uint64_t checksum = OpenVINOInputTracker::Checksum(data, size);
+    unchanged = copied && checksum == binding.checksum;
+    binding.checksum = checksum;
+  }
+  if (unchanged) {
+    input_tracker_->RecordSkipped(size);
+    return;
+  }
+  std::memcpy(binding.tensor.data(), data, size);
+  binding.source = data;
+  input_tracker_->RecordCopied(size);
+}
+
+TfLiteStatus OpenVINODelegateCore::PrepareShapes(
+    TfLiteOpaqueContext *context) {
+  // Prepare follows the Init of every kernel, which compiled their
+  // partitions unless the compile pool still does.
+  if (compiled_partitions_ != nullptr) compiled_partitions_->TrimReleased();
+  for (size_t i = 0; i < compute_inputs_.size(); i++) {
+    const TfLiteOpaqueTensor *tensor =
+        TfLiteOpaqueContextGetOpaqueTensor(context, compute_inputs_[i]);
+    if (tensor == nullptr) return kTfLiteError;
+    const ov::Shape shape = GetShape(tensor);
+    if (!input_shapes_[i].compatible(shape)) {
+      TFLITE_LOG(ERROR) << "Input " << i << " of partition " << partition_key_
+                        << " was resized to " << shape
+                        << ", the model accepts " << input_shapes_[i]
+                        << (dynamic_shapes_ ? "" : ", see dynamic_shapes")
+                        << "\n";
+      return kTfLiteError;
+    }
+  }
+  if (shape_buckets_ != nullptr &&
+      GetBucketedLength(context) > shape_buckets_->getMaxLength()) {
+    TFLITE_LOG(ERROR) << "Inputs of partition " << partition_key_
+                      << " were resized past the largest shape bucket "
+                      << shape_buckets_->getMaxLength() << "\n";
+    return kTfLiteError;
+  }
+  return kTfLiteOk;
+}
+
+int64_t OpenVINODelegateCore::GetBucketedLength(
+    TfLiteOpaqueContext *context) const {
+  int64_t length = 0;
+  for (int t : compute_inputs_) {
+    const TfLiteOpaqueTensor *tensor =
+        TfLiteOpaqueContextGetOpaqueTensor(context, t);
+    if (TfLiteOpaqueTensorNumDims(tensor) > shape_buckets_->getAxis())
+      length = std::max<int64_t>(
+          length, TfLiteOpaqueTensorDim(tensor, shape_buckets_->getAxis()));
+  }
+  return length;
+}
+
+TfLiteStatus OpenVINODelegateCore::SelectBucket(TfLiteOpaqueContext *context) {
+  const int bucket = shape_buckets_->Select(GetBucketedLength(context));
+  if (bucket < 0) return kTfLiteError;
+  if (buckets_[bucket].infer_requests == nullptr &&
+      CompileBucket(bucket) != kTfLiteOk)
+    return kTfLiteError;
+  if (infer_requests_ != buckets_[bucket].infer_requests) {
+    infer_requests_ = buckets_[bucket].infer_requests;
+    slot_index_ = 0;
+  }
+  return kTfLiteOk;
+}
+
+TfLiteStatus OpenVINODelegateCore::CompileBucket(size_t bucket) {
+  Bucket &entry = buckets_[bucket];
+  const int64_t length = shape_buckets_->getLength(bucket);
+  // Every bucket is a partition of its own to the caches, and shared with
+  // the kernels of other interpreters.
+  const std::string key = partition_key_.empty()
+                              ? ""
+                              : partition_key_ + "-b" + std::to_string(length);
+  if (compiled_partitions_ != nullptr && !key.empty()) {
+    entry.infer_requests = compiled_partitions_->FindInferRequestPool(key);
+    if (entry.infer_requests != nullptr) return kTfLiteOk;
+  }
+
+  std::map<size_t, ov::PartialShape> shapes;
+  for (size_t i = 0; i < input_shapes_.size(); i++) {
+    shapes[i] = input_shapes_[i];
+    if (shapes[i].rank().get_length() > shape_buckets_->getAxis())
+      shapes[i][shape_buckets_->getAxis()] = length;
+  }
+  if (CompileReshaped(key, shapes, entry.compiled_model, entry.mapped_blob) !=
+      kTfLiteOk)
+    return kTfLiteError;
+
+  if (compiled_partitions_ != nullptr && !key.empty()) {
+    entry.infer_requests = compiled_partitions_->GetInferRequestPool(
+        key, entry.compiled_model, num_infer_requests_);
+  } else {
+    entry.infer_requests = std::make_shared<OpenVINOInferRequestPool>(
+        entry.compiled_model, num_infer_requests_);
+  }
+  return kTfLiteOk;
+}
+
+TfLiteStatus OpenVINODelegateCore::CompileReshaped(
+    const std::string &key, const std::map<size_t, ov::PartialShape> &shapes,
+    ov::CompiledModel &compiled_model,
+    std::shared_ptr<MappedBlob> &mapped_blob) {
+  ov::Core &core = shared_core_->getCore();
+  bool imported = false;
+  if (!key.empty()) {
+    imported = compiled_partitions_ != nullptr &&
+               compiled_partitions_->Import(key, core, ov_device_,
+                                            compiled_model);
+    if (!imported && model_cache_ != nullptr)
+      imported = model_cache_->Load(key, core, ov_device_, compiled_model,
+                                    &mapped_blob);
+  }
+  if (!imported) {
+    if (!model_) return kTfLiteError;
+    try {
+      std::shared_ptr<ov::Model> model = model_->clone();
+      model->reshape(shapes);
+      compiled_model =
+          core.compile_model(model, ov_device_, compile_properties_);
+    } catch (const std::exception &e) {
+      TFLITE_LOG(ERROR) << "Unable to compile reshaped partition " << key
+                        << ": " << e.what() << "\n";
+      return kTfLiteError;
+    }
+    if (model_cache_ != nullptr && !key.empty())
+      model_cache_->Store(key, compiled_model);
+  }
+  if (compiled_partitions_ != nullptr && !key.empty())
+    compiled_partitions_->Register(key, compiled_model);
+  return kTfLiteOk;
+}
+
+TfLiteStatus OpenVINODelegateCore::PrepareBatching(
+    TfLiteOpaqueContext *context, const TfLiteOpaqueDelegateParams *params) {
+  if (dynamic_shapes_ || shape_buckets_ != nullptr ||
+      std::find(preprocessed_.begin(), preprocessed_.end(), true) !=
+          preprocessed_.end())
+    return kTfLiteError;
+  // Rows are stacked along the first axis.
+  std::vector<size_t> input_rows, output_rows;
+  for (int t : compute_inputs_) {
+    const TfLiteOpaqueTensor *tensor =
+        TfLiteOpaqueContextGetOpaqueTensor(context, t);
+    if (TfLiteOpaqueTensorNumDims(tensor) < 1 ||
+        TfLiteOpaqueTensorDim(tensor, 0) != 1)
+      return kTfLiteError;
+    input_rows.push_back(TfLiteOpaqueTensorByteSize(tensor));
+  }
+  for (int t : outputs_) {
+    const TfLiteOpaqueTensor *tensor =
+        TfLiteOpaqueContextGetOpaqueTensor(context, t);
+    if (TfLiteOpaqueTensorNumDims(tensor) < 1 ||
+        TfLiteOpaqueTensorDim(tensor, 0) != 1)
+      return kTfLiteError;
+    output_rows.push_back(TfLiteOpaqueTensorByteSize(tensor));
+  }
+
+  const std::string key =
+      partition_key_.empty()
+          ? ""
+          : partition_key_ + "-n" + std::to_string(max_batch_size_);
+  if (compiled_partitions_ != nullptr && !key.empty())
+    batcher_ = compiled_partitions_->FindBatcher(key);
+  if (batcher_ == nullptr) {
+    if (BuildModel(context, params) != kTfLiteOk) return kTfLiteError;
+    std::map<size_t, ov::PartialShape> shapes;
+    for (size_t i = 0; i < input_shapes_.size(); i++) {
+      shapes[i] = input_shapes_[i];
+      shapes[i][0] = max_batch_size_;
+    }
+    ov::CompiledModel compiled_model;
+    std::shared_ptr<MappedBlob> mapped_blob;
+    if (CompileReshaped(key, shapes, compiled_model, mapped_blob) != kTfLiteOk)
+      return kTfLiteError;
+    ReleaseModel();
+    // Operations with a fixed target shape may not follow the batch.
+    for (size_t o = 0; o < output_rows.size(); o++) {
+      const ov::Output<const ov::Node> output = compiled_model.output(o);
+      if (output.get_partial_shape().is_dynamic() ||
+          ov::shape_size(output.get_shape()) *
+                  output.get_element_type().size() !=
+              output_rows[o] * max_batch_size_)
+        return kTfLiteError;
+    }
+
+    // Batches run one at a time, a single request is enough. The batcher
+    // outlives this kernel, it holds what it uses.
+    auto infer_requests =
+        std::make_shared<OpenVINOInferRequestPool>(compiled_model, 1);
+    batcher_ = std::make_shared<OpenVINORequestBatcher>(
+        max_batch_size_, batch_timeout_,
+        [infer_requests, mapped_blob, input_rows, output_rows](
+            OpenVINORequestBatcher::Request *const *requests, size_t count) {
+          return RunBatch(*infer_requests, input_rows, output_rows, requests,
+                          count);
+        });
+    if (compiled_partitions_ != nullptr && !key.empty())
+      batcher_ = compiled_partitions_->AddBatcher(key, batcher_);
+  }
+
+  batch_inputs_.assign(compute_inputs_.size(), nullptr);
+  batch_outputs_.assign(outputs_.size(), nullptr);
+  batch_request_.inputs = batch_inputs_.data();
+  batch_request_.outputs = batch_outputs_.data();
+  batcher_->AddSubmitter();
+  return kTfLiteOk;
+}
+
+TfLiteStatus OpenVINODelegateCore::InferBatched(TfLiteOpaqueContext *context) {
+  if (batcher_ == nullptr) return kTfLiteError;
+  for (size_t i = 0; i < compute_inputs_.size(); i++) {
+    batch_inputs_[i] = TfLiteOpaqueTensorData(
+        TfLiteOpaqueContextGetOpaqueTensor(context, compute_inputs_[i]));
+    if (batch_inputs_[i] == nullptr) return kTfLiteError;
+  }
+  for (size_t o = 0; o < outputs_.size(); o++) {
+    batch_outputs_[o] = TfLiteOpaqueTensorData(
+        TfLiteOpaqueContextGetOpaqueTensor(context, outputs_[o]));
+    if (batch_outputs_[o] == nullptr) return kTfLiteError;
+  }
+  return batcher_->Submit(batch_request_);
+}
+
+TfLiteStatus OpenVINODelegateCore::Infer() {
+  if (slot_ == nullptr) return kTfLiteError;
+  bool started = false;
+  try {
+    if (slot_->callback_set) {
+      // Left by StartInfer, it would release the request behind our back.
+      slot_->request.set_callback([](std::exception_ptr) {});
+      slot_->callback_set = false;
+    }
+    slot_->request.start_async();
+    started = true;
+    if (slot_->request.wait_for(kInferTimeout)) return kTfLiteOk;
+  } catch (const std::exception &e) {
+    TFLITE_LOG(ERROR) << "Inference of partition " << partition_key_
+                      << " failed: " << e.what() << "\n";
+    // A request that failed to start may still be running another one.
+    return ReleaseSlot(kTfLiteError, started);
+  }
+
+  TFLITE_LOG(ERROR) << "Inference of partition " << partition_key_
+                    << " timed out\n";
+  bool finished = false;
+  try {
+    slot_->request.cancel();
+    finished = slot_->request.wait_for(kCancelTimeout);
+  } catch (const std::exception &) {
+    // Rethrown by wait_for once the cancelled inference stopped.
+    finished = true;
+  }
+  return ReleaseSlot(kTfLiteError, finished);
+}
+
+TfLiteStatus OpenVINODelegateCore::ResolveOutputs(
+    TfLiteOpaqueContext *context, const OpenVINOInferRequestPool::Slot &slot) {
+  // Sized once, the outputs of a partition do not change.
+  output_targets_.resize(slot.outputs.size());
+  for (size_t o = 0; o < slot.outputs.size(); o++) {
+    const OpenVINOInferRequestPool::Binding &binding = slot.outputs[o];
+    OutputTarget &target = output_targets_[o];
+    const TfLiteOpaqueTensor *tensor =
+        TfLiteOpaqueContextGetOpaqueTensor(context, outputs_[o]);
+    void *data = TfLiteOpaqueTensorData(tensor);
+    const size_t size = TfLiteOpaqueTensorByteSize(tensor);
+    if (data == nullptr) return kTfLiteError;
+    target = OutputTarget();
+    if (binding.bound == data) continue;
+    target.data = data;
+    target.size = size;
+
+    if (shape_buckets_ != nullptr && !SameShape(binding.shape, tensor) &&
+        GetRows(tensor, binding.shape, shape_buckets_->getAxis(),
+                binding.tensor.get_element_type().size(), target.outer,
+                target.item_bytes)) {
+      target.crop = true;
+      target.length = TfLiteOpaqueTensorDim(tensor, shape_buckets_->getAxis());
+      continue;
+    }
+    if (size != binding.tensor.get_byte_size()) {
+      TFLITE_LOG(ERROR) << "Output " << o << " holds " << size
+                        << " bytes, the compiled model produces "
+                        << binding.tensor.get_byte_size() << "\n";
+      return kTfLiteError;
+    }
+  }
+  return kTfLiteOk;
+}
+
+void OpenVINODelegateCore::WriteOutputs(
+    const OpenVINOInferRequestPool::Slot &slot) const {
+  for (size_t o = 0; o < slot.outputs.size(); o++) {
+    const OpenVINOInferRequestPool::Binding &binding = slot.outputs[o];
+    const OutputTarget &target = output_targets_[o];
+    if (target.data == nullptr) continue;
+    if (target.crop) {
+      OpenVINOShapeBuckets::Crop(binding.tensor.data(), target.data,
+                                 target.outer,
+                                 binding.shape[shape_buckets_->getAxis()],
+                                 target.length, target.item_bytes);
+      continue;
+    }
+    std::memcpy(target.data, binding.tensor.data(), target.size);
+  }
+}
+
+TfLiteStatus OpenVINODelegateCore::FetchOutputs(TfLiteOpaqueContext *context) {
+  if (slot_ == nullptr) return kTfLiteError;
+  if (ResolveOutputs(context, *slot_) != kTfLiteOk)
+    return ReleaseSlot(kTfLiteError);
+  WriteOutputs(*slot_);
+  return ReleaseSlot(kTfLiteOk);
+}
+
+void OpenVINODelegateCore::WaitForStartedInference() {
+  std::unique_lock<std::mutex> lock(started_mutex_);
+  started_completed_.wait(lock, [this] { return !started_; });
+}
+
+TfLiteStatus OpenVINODelegateCore::StartInfer(TfLiteOpaqueContext *context) {
+  if (slot_ == nullptr || async_inference_ == nullptr) return kTfLiteError;
+  // Where the outputs go is read from the context here, on the thread
+  // invoking the interpreter; the callback only writes the OpenVINO tensors
+  // there and never touches the context.
+  if (ResolveOutputs(context, *slot_) != kTfLiteOk)
+    return ReleaseSlot(kTfLiteError);
+  // Captured rather than read from members in the callback, so that it
+  // completes once this core signalled started_completed_. The request owns
+  // the callback, the pool is held by raw pointer to avoid a cycle; it stays
+  // alive as tier switches and destruction wait for the inference first,
+  // and so does this core, whose output_targets_ the callback writes.
+  OpenVINOInferRequestPool::Slot *slot = slot_;
+  OpenVINOInferRequestPool *infer_requests = infer_requests_.get();
+  std::shared_ptr<OpenVINOAsyncInference> async_inference = async_inference_;
+  const size_t index = slot_index_;
+  slot_ = nullptr;
+
+  {
+    std::lock_guard<std::mutex> lock(started_mutex_);
+    started_ = true;
+  }
+  async_inference->Begin();
+  slot->callback_set = true;
+  slot->request.set_callback([this, slot, infer_requests, async_inference,
+                              index](std::exception_ptr error) {
+    TfLiteStatus status = kTfLiteError;
+    if (error == nullptr) {
+      WriteOutputs(*slot);
+      status = kTfLiteOk;
+    } else {
+      try {
+        std::rethrow_exception(error);
+      } catch (const std::exception &e) {
+        TFLITE_LOG(ERROR) << "Inference of partition " << partition_key_
+                          << " failed: " << e.what() << "\n";
+      }
+    }
+    infer_requests->Release(index);
+    {
+      // Notified under the lock, this core may be destroyed right after.
+      std::lock_guard<std::mutex> lock(started_mutex_);
+      started_ = false;
+      started_completed_.notify_all();
+    }
+    async_inference->End(status);
+  });
+  try {
+    slot->request.start_async();
+  } catch (const std::exception &e) {
+    TFLITE_LOG(ERROR) << "Unable to start inference of partition "
+                      << partition_key_ << ": " << e.what() << "\n";
+    infer_requests->Release(index);
+    {
+      std::lock_guard<std::mutex> lock(started_mutex_);
+      started_ = false;
+      started_completed_.notify_all();
+    }
+    async_inference->End(kTfLiteError);
+    return kTfLiteError;
+  }
+  return kTfLiteOk;
+}
+
+TfLiteStatus OpenVINODelegateCore::FinishCompilation() {
+  OpenVINOCompiledPartitions::PreparedPartition prepared =
+      compile_pending_.get();
+  compile_pending_ = {};
+  if (!prepared.compiled) return kTfLiteError;
+  mapped_blob_ = prepared.mapped_blob;
+  compiled_model_ = prepared.compiled_model;
+  SetCompiledModel(compiled_model_, /*shared=*/true);
+  return kTfLiteOk;
+}
+
+void OpenVINODelegateCore::CompileFastTier(
+    const std::shared_ptr<ov::Model> &model) {
+  ov::CompiledModel fast_tier;
+  try {
+    fast_tier = shared_core_->getCore().compile_model(model, kFastTierDevice);
+  } catch (const std::exception &e) {
+    TFLITE_LOG(WARN) << "Unable to compile the fast tier: " << e.what()
+                     << ", waiting for the optimized model\n";
+    return;
+  }
+  // compiled_model_ belongs to the background compilation until it is done,
+  // the infer requests keep the fast tier alive on their own.
+  SetCompiledModel(fast_tier, /*shared=*/false);
+  on_fast_tier_ = true;
+  fast_tier_since_ = std::chrono::steady_clock::now();
+}
+
+TfLiteStatus OpenVINODelegateCore::WaitForCompiledModel() {
+  // A tier switch must not release infer requests still running.
+  WaitForStartedInference();
+  if (on_fast_tier_ && compile_pending_.valid() &&
+      compile_pending_.wait_for(std::chrono::seconds(0)) ==
+          std::future_status::ready) {
+    if (FinishCompilation() == kTfLiteOk) {
+      on_fast_tier_ = false;
+      compiled_partitions_->RecordTierSwitch(
+          std::chrono::duration_cast<std::chrono::milliseconds>(
+              std::chrono::steady_clock::now() - fast_tier_since_));
+    } else {
+      TFLITE_LOG(WARN) << "Optimized compilation of partition "
+                       << partition_key_ << " failed, keeping the fast tier\n";
+    }
+  } else if (!on_fast_tier_ && compile_pending_.valid() &&
+             FinishCompilation() != kTfLiteOk) {
+    TFLITE_LOG(ERROR) << "Background compilation of partition "
+                      << partition_key_ << " failed\n";
+    return kTfLiteError;
+  }
+
+  if (tiered_compilation_ && compiled_partitions_ != nullptr)
+    compiled_partitions_->RecordTieredInvocation(!on_fast_tier_);
+  return kTfLiteOk;
+}
+
+TfLiteStatus OpenVINODelegateCore::CreateGraphfromTfLite(
+    TfLiteOpaqueContext *context, const TfLiteOpaqueDelegateParams *params) {
+  if (CollectPartition(context, params) != kTfLiteOk) return kTfLiteError;
+  if (max_batch_size_ > 1) {
+    if (PrepareBatching(context, params) == kTfLiteOk) return kTfLiteOk;
+    batcher_ = nullptr;
+    TFLITE_LOG(WARN) << "Unable to batch partition " << partition_key_
+                     << ", running it unbatched\n";
+  }
+  // Shape buckets are compiled by SelectBucket once they are needed.
+  if (shape_buckets_ != nullptr) return BuildModel(context, params);
+
+  if (compiled_partitions_ != nullptr)
+    compile_pending_ = compiled_partitions_->GetPrepared(partition_key_);
+
+  if (compile_pool_ != nullptr) {
+    // Tiering only pays off for devices that compile slower than the fast
+    // tier, and not for blobs that are merely imported.
+    const bool tiered = tiered_compilation_ &&
+                        compiled_partitions_ != nullptr &&
+                        ov_device_ != kFastTierDevice;
+    std::shared_ptr<ov::Model> fast_tier_model;
+    if (!compile_pending_.valid()) {
+      // Built on this thread as it reads context, compiled in the background.
+      if (BuildModelUnlessPrecompiled(context, params) != kTfLiteOk)
+        return kTfLiteError;
+      // The background compilation gets model_, the fast tier its own copy.
+      if (tiered && model_) fast_tier_model = model_->clone();
+      if (compiled_partitions_ != nullptr)
+        compiled_partitions_->BeginPreparing();
+      compile_pending_ =
+          compile_pool_->Submit([this] { return CompilePreparedPartition(); })
+              .share();
+      if (compiled_partitions_ != nullptr)
+        compiled_partitions_->AddPrepared(partition_key_, compile_pending_);
+    } else if (tiered && !IsPrecompiled() &&
+               compile_pending_.wait_for(std::chrono::seconds(0)) !=
+                   std::future_status::ready) {
+      // Prepared by Initialize, which kept its model to itself. This model
+      // is only compiled for the fast tier, once that is done it can go.
+      if (BuildModel(context, params) != kTfLiteOk) return kTfLiteError;
+      CompileFastTier(model_);
+      ReleaseModel();
+      return kTfLiteOk;
+    }
+    if (fast_tier_model != nullptr) CompileFastTier(fast_tier_model);
+    return kTfLiteOk;
+  }
+
+  if (compile_pending_.valid() && FinishCompilation() == kTfLiteOk)
+    return kTfLiteOk;
+  // The partition was not prepared ahead or failed to compile there.
+  if (ImportPartition() != kTfLiteOk) {
+    if (BuildModel(context, params) != kTfLiteOk) return kTfLiteError;
+    if (CompilePartition() != kTfLiteOk) return kTfLiteError;
+    ReleaseModel();
   }
 
-  infer_request_ = compiled_model_.create_infer_request();
+  SetCompiledModel(compiled_model_, /*shared=*/true);
   return kTfLiteOk;
 }
 
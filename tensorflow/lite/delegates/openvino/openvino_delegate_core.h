@@ -4,54 +4,326 @@
 
 #ifndef TENSORFLOW_LITE_DELEGATES_OPENVINO_DELEGATE_CORE_H_
 #define TENSORFLOW_LITE_DELEGATES_OPENVINO_DELEGATE_CORE_H_
+#include <chrono>
 #include <iostream>
+#include <map>
 #include <openvino/openvino.hpp>
+#include <openvino/pass/constant_folding.hpp>
 #include <openvino/pass/manager.hpp>
 #include <openvino/pass/serialize.hpp>
 #include <openvino/runtime/core.hpp>
 #include <vector>
 
+#include "openvino_async_inference.h"
+#include "openvino_compile_pool.h"
+#include "openvino_compiled_partitions.h"
+#include "openvino_core_registry.h"
 #include "openvino_graph_builder.h"
+#include "openvino_infer_request_pool.h"
+#include "openvino_input_tracker.h"
+#include "openvino_model_cache.h"
+#include "openvino_preprocessing.h"
+#include "openvino_shape_buckets.h"
 #include "operations/openvino_node_manager.h"
 
 namespace tflite {
 namespace openvinodelegate {
+// Settings of a delegate, shared by all of its kernels.
+struct OpenVINOKernelSettings {
+  std::string device = "CPU";
+  // Passed to compile_model, values are strings parsed by the plugin.
+  ov::AnyMap properties;
+  bool tiered_compilation = false;
+  // Bind TFLite tensor buffers to the infer request instead of copying.
+  bool zero_copy = true;
+  // Infer requests shared by the interpreters running a partition, 0 for
+  // ov::optimal_number_of_infer_requests of the compiled model.
+  size_t num_infer_requests = 0;
+  // Leave batch and spatial axes of the inputs dynamic, so that they can be
+  // resized without compiling the partition again.
+  bool dynamic_shapes = false;
+  // Set to compile the partitions once per bucket, see SelectBucket.
+  std::shared_ptr<OpenVINOShapeBuckets> shape_buckets;
+  // Set to feed the inputs it applies to raw frames, converted by the
+  // compiled model. Ignored with dynamic_shapes or shape_buckets.
+  std::shared_ptr<OpenVINOPreprocessing> preprocessing;
+  // Build constants over the TFLite model rather than copies of it, see
+  // OpenVINOGraphBuilder.
+  bool share_constants = false;
+  // Drop the builder and the model once the partition is compiled, see
+  // ReleaseModel.
+  bool release_models = true;
+  // Sample the resident memory around each release, see ReleaseModel.
+  bool record_release_stats = false;
+  // Set to skip copying inputs that did not change, see CopyInput.
+  std::shared_ptr<OpenVINOInputTracker> input_tracker;
+  // Above 1, invocations of other interpreters are batched, see
+  // InferBatched.
+  size_t max_batch_size = 0;
+  std::chrono::microseconds batch_timeout{0};
+  // Set to let Eval return once inference started, see StartInfer.
+  std::shared_ptr<OpenVINOAsyncInference> async_inference;
+};
+
 class OpenVINODelegateCore {
  public:
-  OpenVINODelegateCore(std::string_view plugins_path)
-      : openvino_delegate_core_(ov::Core()) {
+  // With a compile_pool, CreateGraphfromTfLite only builds the model and
+  // leaves compilation to the pool; WaitForCompiledModel has to be called
+  // before the infer request is used. With settings.tiered_compilation as
+  // well, the partition is first compiled for kFastTierDevice and runs there
+  // until the compilation for the target device completes.
+  OpenVINODelegateCore(
+      std::string_view plugins_path,
+      std::shared_ptr<OpenVINOModelCache> model_cache = nullptr,
+      std::shared_ptr<OpenVINOCompiledPartitions> compiled_partitions = nullptr,
+      std::shared_ptr<OpenVINOCompilePool> compile_pool = nullptr,
+      OpenVINOKernelSettings settings = {})
+      : shared_core_(
+            OpenVINOCoreRegistry::Acquire(std::string(plugins_path))),
+        model_cache_(std::move(model_cache)),
+        compiled_partitions_(std::move(compiled_partitions)),
+        compile_pool_(std::move(compile_pool)),
+        tiered_compilation_(settings.tiered_compilation),
+        zero_copy_(settings.zero_copy),
+        share_constants_(settings.share_constants),
+        release_models_(settings.release_models),
+        record_release_stats_(settings.record_release_stats),
+        num_infer_requests_(settings.num_infer_requests),
+        // Shape buckets take precedence, their requests are never reshaped.
+        dynamic_shapes_(settings.dynamic_shapes &&
+                        settings.shape_buckets == nullptr),
+        shape_buckets_(std::move(settings.shape_buckets)),
+        buckets_(shape_buckets_ != nullptr ? shape_buckets_->getCount() : 0),
+        // Preprocessing resizes to the static shape the model was built for.
+        preprocessing_(settings.dynamic_shapes || shape_buckets_ != nullptr
+                           ? nullptr
+                           : std::move(settings.preprocessing)),
+        max_batch_size_(settings.max_batch_size),
+        batch_timeout_(settings.batch_timeout),
+        input_tracker_(std::move(settings.input_tracker)),
+        async_inference_(std::move(settings.async_inference)),
+        ov_device_(std::move(settings.device)),
+        compile_properties_(std::move(settings.properties)) {
     plugins_location_ = plugins_path;
   }
-  TfLiteStatus OpenVINODelegateInit() {
-    std::vector<std::string> ov_devices =
-        openvino_delegate_core_.get_available_devices();
-    if (std::find(ov_devices.begin(), ov_devices.end(), "CPU") ==
-        ov_devices.end()) {
-      return kTfLiteDelegateError;
-    } else {
-      return kTfLiteOk;
-    }
+
+  // A compilation still running on the pool or an inference started by
+  // StartInfer refers to this core.
+  ~OpenVINODelegateCore() {
+    if (compile_pending_.valid()) compile_pending_.wait();
+    WaitForStartedInference();
+    if (batcher_ != nullptr) batcher_->RemoveSubmitter();
   }
 
-  std::vector<int> getComputeInputs() { return compute_inputs_; }
+  // Device the fast tier of tiered compilation is compiled for. The CPU
+  // plugin compiles in a fraction of the time accelerator plugins take.
+  static constexpr char kFastTierDevice[] = "CPU";
+
+  TfLiteStatus OpenVINODelegateInit();
+
+  // Longest an inference may take before Infer gives up on it.
+  static constexpr std::chrono::milliseconds kInferTimeout{10000};
+  // Longest Infer waits for a timed out inference to stop once cancelled.
+  static constexpr std::chrono::milliseconds kCancelTimeout{1000};
+
+  // Steady-state inference, split so that the part run by the delegate can
+  // be checked to not allocate. BindTensors takes an infer request of the
+  // partition and binds the TFLite buffers of the boundary tensors to it,
+  // only when TFLite moved them, copying the inputs that cannot be bound.
+  // The result nodes already transpose 4D outputs back to NHWC, the layout
+  // TFLite expects. Infer runs the request and FetchOutputs copies the
+  // outputs that were not bound, then hands the request back. The request
+  // is also handed back by whichever of them fails.
+  TfLiteStatus BindTensors(TfLiteOpaqueContext *context);
+  TfLiteStatus Infer();
+  TfLiteStatus FetchOutputs(TfLiteOpaqueContext *context);
+
+  // Replaces Infer and FetchOutputs with settings.async_inference, while the
+  // application has a completion callback set on it: starts the request and
+  // returns, the outputs are copied and the request handed back from its
+  // completion callback, which then reports to settings.async_inference.
+  // The next BindTensors waits for the inference to complete. Inputs are
+  // always copied in this mode, so that the application can fill them for
+  // the next invocation meanwhile.
+  TfLiteStatus StartInfer(TfLiteOpaqueContext *context);
 
-  std::vector<int> getOutputs() { return outputs_; }
+  // Whether the last BindTensors prepared for StartInfer.
+  bool isAsync() const { return async_invoke_; }
 
-  ov::InferRequest getInferRequest() const { return infer_request_; }
+  // Replaces BindTensors, Infer and FetchOutputs with
+  // settings.max_batch_size: the invocation joins those the kernels of other
+  // interpreters make concurrently on the same partition, which run as one
+  // inference of a model compiled for max_batch_size rows, and returns once
+  // its outputs were copied back. Only applies to partitions whose inputs
+  // and outputs all have a batch of 1 and static shapes, and whose inputs
+  // are not preprocessed; others run alone.
+  TfLiteStatus InferBatched(TfLiteOpaqueContext *context);
+
+  bool isBatched() const { return batcher_ != nullptr; }
+
+  // Called from Prepare once TFLite (re)allocated the tensors. Checks the
+  // dims of the inputs against those the model was built for; with
+  // settings.dynamic_shapes only the innermost axis has to match, with
+  // settings.shape_buckets all but the bucketed axis, which must fit in the
+  // largest bucket. The output dims were propagated by TFLite, BindTensors
+  // reshapes the infer request to both on its next use, no compilation takes
+  // place.
+  TfLiteStatus PrepareShapes(TfLiteOpaqueContext *context);
 
   TfLiteStatus CreateGraphfromTfLite(TfLiteOpaqueContext *context,
                                      const TfLiteOpaqueDelegateParams *params);
 
+  // Split of CreateGraphfromTfLite used to compile partitions ahead of their
+  // kernels. PreparePartition imports the partition or reads everything it
+  // needs from context to build it, so CompilePreparedPartition can run on
+  // another thread afterwards.
+  TfLiteStatus PreparePartition(TfLiteOpaqueContext *context,
+                                const TfLiteOpaqueDelegateParams *params);
+  OpenVINOCompiledPartitions::PreparedPartition CompilePreparedPartition();
+
+  const std::string &getPartitionKey() const { return partition_key_; }
+
+  // Waits for a background compilation started by CreateGraphfromTfLite and
+  // creates the infer request. Returns immediately once compiled. A partition
+  // running on its fast tier does not wait, it switches to the optimized
+  // model once that one is ready.
+  TfLiteStatus WaitForCompiledModel();
+
  private:
+  TfLiteStatus CollectPartition(TfLiteOpaqueContext *context,
+                                const TfLiteOpaqueDelegateParams *params);
+  TfLiteStatus BuildModelUnlessPrecompiled(
+      TfLiteOpaqueContext *context, const TfLiteOpaqueDelegateParams *params);
+  TfLiteStatus ImportPartition();
+  TfLiteStatus CompilePartition();
+  TfLiteStatus FinishCompilation();
+  // Infer requests of compiled_model, shared with the kernels of other
+  // interpreters running the same partition unless shared is false.
+  void SetCompiledModel(const ov::CompiledModel &compiled_model, bool shared);
+  bool CanBind(const OpenVINOInferRequestPool::Binding &binding,
+               const void *data, size_t size) const;
+  // Hands the infer request back, see OpenVINOInferRequestPool::Release for
+  // finished.
+  TfLiteStatus ReleaseSlot(TfLiteStatus status, bool finished = true);
+  // Copies size bytes of input index from data into the request's own
+  // tensor, unless it still holds them: when the tensor was last copied
+  // from data and settings.input_tracker says the input is unchanged, as
+  // marked by the application or by a checksum equal to the last one.
+  void CopyInput(OpenVINOInferRequestPool::Binding &binding, size_t index,
+                 const void *data, size_t size, bool marked);
+  // Copying the outputs that were not bound is split in two, so that
+  // StartInfer's completion callback runs only the second half.
+  // ResolveOutputs reads from context where each output goes into
+  // output_targets_, WriteOutputs copies the request's tensors there.
+  TfLiteStatus ResolveOutputs(TfLiteOpaqueContext *context,
+                              const OpenVINOInferRequestPool::Slot &slot);
+  void WriteOutputs(const OpenVINOInferRequestPool::Slot &slot) const;
+  void WaitForStartedInference();
+  // With settings.shape_buckets, partitions are built with a dynamic model
+  // but only compiled with the inputs reshaped to the bucket their bucketed
+  // axis fits in, on the first invocation needing that bucket. BindTensors
+  // zero-pads shorter inputs into the infer request and WriteOutputs crops
+  // the outputs whose dims TFLite propagated from the unpadded inputs.
+  TfLiteStatus SelectBucket(TfLiteOpaqueContext *context);
+  TfLiteStatus CompileBucket(size_t bucket);
+  // Imports key from the caches, or compiles model_ with its inputs reshaped
+  // to shapes and stores it under key. An empty key skips the caches.
+  TfLiteStatus CompileReshaped(const std::string &key,
+                               const std::map<size_t, ov::PartialShape> &shapes,
+                               ov::CompiledModel &compiled_model,
+                               std::shared_ptr<MappedBlob> &mapped_blob);
+  TfLiteStatus PrepareBatching(TfLiteOpaqueContext *context,
+                               const TfLiteOpaqueDelegateParams *params);
+  int64_t GetBucketedLength(TfLiteOpaqueContext *context) const;
+  bool IsPrecompiled();
+  // Frees the builder, with its interim nodes, and the model, with its
+  // constants, once the partition is compiled; inference only needs the
+  // compiled model. Kept with settings.shape_buckets, whose buckets are
+  // compiled from the model on demand. The heap is trimmed once the
+  // partitions are compiled, see OpenVINOCompiledPartitions::TrimReleased,
+  // or right away to sample the resident memory with
+  // settings.record_release_stats.
+  void ReleaseModel();
+  void CompileFastTier(const std::shared_ptr<ov::Model> &model);
+  TfLiteStatus CollectComputeInputs(TfLiteOpaqueContext *context,
+                                    const TfLiteOpaqueDelegateParams *params);
+  TfLiteStatus BuildModel(TfLiteOpaqueContext *context,
+                          const TfLiteOpaqueDelegateParams *params);
+
   std::unique_ptr<OpenVINOGraphBuilder> openvino_graph_builder_;
-  ov::Core openvino_delegate_core_;
+  std::shared_ptr<OpenVINOSharedCore> shared_core_;
+  std::shared_ptr<OpenVINOModelCache> model_cache_;
+  std::shared_ptr<OpenVINOCompiledPartitions> compiled_partitions_;
+  std::shared_ptr<OpenVINOCompilePool> compile_pool_;
+  std::shared_future<OpenVINOCompiledPartitions::PreparedPartition>
+      compile_pending_;
+  bool tiered_compilation_;
+  bool zero_copy_;
+  bool share_constants_;
+  bool release_models_;
+  bool record_release_stats_;
+  size_t num_infer_requests_;
+  bool dynamic_shapes_;
+  std::shared_ptr<OpenVINOShapeBuckets> shape_buckets_;
+  struct Bucket {
+    std::shared_ptr<MappedBlob> mapped_blob;
+    ov::CompiledModel compiled_model;
+    std::shared_ptr<OpenVINOInferRequestPool> infer_requests;
+  };
+  std::vector<Bucket> buckets_;
+  std::shared_ptr<OpenVINOPreprocessing> preprocessing_;
+  size_t max_batch_size_;
+  std::chrono::microseconds batch_timeout_;
+  std::shared_ptr<OpenVINORequestBatcher> batcher_;
+  // Buffers of this kernel's row, refreshed by InferBatched.
+  std::vector<const void *> batch_inputs_;
+  std::vector<void *> batch_outputs_;
+  OpenVINORequestBatcher::Request batch_request_;
+  std::shared_ptr<OpenVINOInputTracker> input_tracker_;
+  std::shared_ptr<OpenVINOAsyncInference> async_inference_;
+  bool async_invoke_ = false;
+  // TFLite buffer an output is copied to, null when bound. With crop, the
+  // first length items of each of outer rows of item_bytes are copied.
+  struct OutputTarget {
+    void *data = nullptr;
+    size_t size = 0;
+    bool crop = false;
+    size_t outer = 0;
+    size_t length = 0;
+    size_t item_bytes = 0;
+  };
+  std::vector<OutputTarget> output_targets_;
+  // Whether an inference started by StartInfer is still running.
+  std::mutex started_mutex_;
+  std::condition_variable started_completed_;
+  bool started_ = false;
+  bool on_fast_tier_ = false;
+  // Whether BuildModelUnlessPrecompiled imported the partition.
+  bool imported_ = false;
+  std::chrono::steady_clock::time_point fast_tier_since_;
   std::string plugins_location_;
   std::shared_ptr<ov::Model> model_;
+  // Read-only mapping the compiled model was imported from, if any. Declared
+  // before compiled_model_ so that it outlives it.
+  std::shared_ptr<MappedBlob> mapped_blob_;
   ov::CompiledModel compiled_model_;
-  std::string ov_device_ = "CPU";
+  std::string ov_device_;
+  ov::AnyMap compile_properties_;
+  std::string partition_key_;
   std::vector<int> compute_inputs_ = {};
+  // Shapes of the model inputs, in the order of compute_inputs_.
+  std::vector<ov::PartialShape> input_shapes_ = {};
+  // Whether the buffer of each input holds a raw frame for preprocessing_,
+  // of the size of the compiled model input rather than the TFLite tensor.
+  std::vector<bool> preprocessed_ = {};
+  // Marks of each input taken from input_tracker_ by this kernel.
+  std::vector<uint64_t> marks_seen_ = {};
   std::vector<int> outputs_ = {};
-  ov::InferRequest infer_request_;
+  std::shared_ptr<OpenVINOInferRequestPool> infer_requests_;
+  // Request taken by BindTensors, which prefers the one used last since the
+  // TFLite buffers of this kernel are still bound to it.
+  OpenVINOInferRequestPool::Slot *slot_ = nullptr;
+  size_t slot_index_ = 0;
 };
 }  // namespace openvinodelegate
 }  // namespace tflite
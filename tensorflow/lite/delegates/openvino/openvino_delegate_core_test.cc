@@ -7,14 +7,34 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <cstdlib>
+#include <new>
+
 #include "openvino_graph_builder.h"
 #include "tensorflow/lite/builtin_ops.h"
 #include "tensorflow/lite/c/c_api.h"
+#include "tensorflow/lite/c/c_api_opaque.h"
 #include "tensorflow/lite/core/kernels/builtin_op_kernels.h"
 #include "tensorflow/lite/interpreter.h"
 #include "tensorflow/lite/interpreter_builder.h"
 #include "tensorflow/lite/kernels/kernel_util.h"
 
+namespace {
+// Heap allocations made by this thread while counting_allocations is set.
+thread_local bool counting_allocations = false;
+thread_local size_t allocations = 0;
+}  // namespace
+
+void* operator new(size_t size) {
+  if (counting_allocations) allocations++;
+  if (void* ptr = std::malloc(size != 0 ? size : 1)) return ptr;
+  throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+
+void operator delete(void* ptr, size_t) noexcept { std::free(ptr); }
+
 class OpenVINODelegateCoreTest : public testing::Test {
  protected:
   TfLiteInterpreter* interpreter_ = nullptr;
@@ -145,3 +165,81 @@ TEST_F(OpenVINODelegateCoreTest, CreateGraphfromTfLite_InvalidParams) {
   TfLiteModelDelete(model_);
   TfLiteOpaqueDelegateDelete(opaque_delegate_);
 }
+
+TEST_F(OpenVINODelegateCoreTest, EvalDoesNotAllocate) {
+  TfLiteOpaqueDelegateBuilder opaque_delegate_builder{};
+  opaque_delegate_builder.Prepare = [](TfLiteOpaqueContext* opaque_context,
+                                       TfLiteOpaqueDelegate* opaque_delegate,
+                                       void* data) -> TfLiteStatus {
+    auto reg_ex = TfLiteRegistrationExternalCreate(
+        kTfLiteBuiltinDelegate, "Test driver Openvino delegate", /*version=*/1);
+    TfLiteRegistrationExternalSetInit(
+        reg_ex,
+        [](TfLiteOpaqueContext* opaque_context, const char* buffer,
+           size_t length) -> void* {
+          auto core =
+              std::make_unique<tflite::openvinodelegate::OpenVINODelegateCore>(
+                  "");
+          if (core->OpenVINODelegateInit() != kTfLiteOk ||
+              core->CreateGraphfromTfLite(
+                  opaque_context,
+                  reinterpret_cast<const TfLiteOpaqueDelegateParams*>(
+                      buffer)) != kTfLiteOk)
+            return nullptr;
+          return core.release();
+        });
+    TfLiteRegistrationExternalSetFree(
+        reg_ex, [](TfLiteOpaqueContext* opaque_context, void* data) {
+          delete static_cast<tflite::openvinodelegate::OpenVINODelegateCore*>(
+              data);
+        });
+    TfLiteRegistrationExternalSetInvoke(
+        reg_ex,
+        [](TfLiteOpaqueContext* opaque_context,
+           TfLiteOpaqueNode* opaque_node) -> TfLiteStatus {
+          auto* core =
+              static_cast<tflite::openvinodelegate::OpenVINODelegateCore*>(
+                  TfLiteOpaqueNodeGetUserData(opaque_node));
+          if (core == nullptr) return kTfLiteError;
+          // Inference itself is up to the OpenVINO plugin, only the work
+          // done by the delegate around it is counted.
+          counting_allocations = true;
+          TfLiteStatus status = core->WaitForCompiledModel();
+          if (status == kTfLiteOk) status = core->BindTensors(opaque_context);
+          counting_allocations = false;
+          if (status == kTfLiteOk) status = core->Infer();
+          counting_allocations = true;
+          if (status == kTfLiteOk) status = core->FetchOutputs(opaque_context);
+          counting_allocations = false;
+          return status;
+        });
+    TfLiteIntArray* execution_plan = nullptr;
+    if (TfLiteOpaqueContextGetExecutionPlan(opaque_context, &execution_plan) !=
+        kTfLiteOk)
+      return kTfLiteError;
+    return TfLiteOpaqueContextReplaceNodeSubsetsWithDelegateKernels(
+        opaque_context, reg_ex, execution_plan, opaque_delegate);
+  };
+
+  model_ = TfLiteModelCreateFromFile("tensorflow/lite/testdata/add.bin");
+  ASSERT_NE(model_, nullptr);
+  opaque_delegate_ = TfLiteOpaqueDelegateCreate(&opaque_delegate_builder);
+  TfLiteInterpreterOptions* options = TfLiteInterpreterOptionsCreate();
+  TfLiteInterpreterOptionsAddDelegate(options, opaque_delegate_);
+  interpreter_ = TfLiteInterpreterCreate(model_, options);
+  TfLiteInterpreterOptionsDelete(options);
+  ASSERT_NE(interpreter_, nullptr);
+  ASSERT_EQ(kTfLiteOk, TfLiteInterpreterAllocateTensors(interpreter_));
+
+  // The first invocation binds the TFLite buffers to the infer request.
+  ASSERT_EQ(kTfLiteOk, TfLiteInterpreterInvoke(interpreter_));
+  for (int i = 0; i < 3; i++) {
+    allocations = 0;
+    ASSERT_EQ(kTfLiteOk, TfLiteInterpreterInvoke(interpreter_));
+    EXPECT_EQ(allocations, 0);
+  }
+
+  TfLiteInterpreterDelete(interpreter_);
+  TfLiteModelDelete(model_);
+  TfLiteOpaqueDelegateDelete(opaque_delegate_);
+}
@@ -8,6 +8,7 @@
 #include "openvino_delegate.h"
 #include "tensorflow/lite/acceleration/configuration/c/delegate_plugin.h"
 #include "tensorflow/lite/acceleration/configuration/c/stable_delegate.h"
+#include "tensorflow/lite/acceleration/configuration/configuration_generated.h"
 #include "tensorflow/lite/c/c_api_types.h"
 #include "tensorflow/lite/c/common.h"
 #include "tensorflow/lite/delegates/utils/experimental/stable_delegate/stable_delegate_interface.h"
@@ -15,10 +16,31 @@
 
 namespace {
 
+// Applies the parts of TFLiteSettings that have an OpenVINO counterpart.
+// The acceleration configuration schema has no OpenVINO table, so only the
+// delegate-agnostic CPU and compilation caching settings are honored.
+void ApplyTFLiteSettings(const tflite::TFLiteSettings &settings,
+                         TfLiteOpenVINODelegateOptions &options) {
+  const tflite::CPUSettings *cpu_settings = settings.cpu_settings();
+  if (cpu_settings != nullptr && cpu_settings->num_threads() > 0)
+    options.inference_num_threads = cpu_settings->num_threads();
+
+  const tflite::CompilationCachingSettings *caching_settings =
+      settings.compilation_caching_settings();
+  if (caching_settings != nullptr && caching_settings->cache_dir() != nullptr)
+    options.cache_dir = caching_settings->cache_dir()->c_str();
+}
+
 TfLiteOpaqueDelegate *OpenVINOStableDelegateCreateFunc(
     const void *tflite_settings) {
   TfLiteOpenVINODelegateOptions options =
       TfLiteOpenVINODelegateOptionsDefault();
+  if (tflite_settings != nullptr) {
+    ApplyTFLiteSettings(
+        *static_cast<const tflite::TFLiteSettings *>(tflite_settings),
+        options);
+  }
+  // The delegate keeps its own copies of the option strings.
   auto delegate =
       std::make_unique<tflite::openvinodelegate::OpenVINODelegate>(&options);
   return tflite::TfLiteOpaqueDelegateFactory::CreateSimpleDelegate(
@@ -5,6 +5,9 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <filesystem>
+#include <string>
+
 #include "delegate/utils/experimental/stable_delegate/delegate_loader.h"
 #include "openvino_delegate.h"
 #include "tensorflow/lite/acceleration/configuration/configuration_generated.h"
@@ -110,4 +113,85 @@ TEST_F(OpenVINODelegateExternalTest, LoadExternalDelegateLibrary) {
   stable_delegate_handle->delegate_plugin->destroy(opaque_delegate);
 }
 
+// Creates the delegate of stable_delegate_handle from TFLiteSettings holding
+// num_threads and cache_dir.
+TfLiteOpaqueDelegate *CreateWithSettings(
+    const TfLiteStableDelegate *stable_delegate_handle, int num_threads,
+    const std::string &cache_dir) {
+  flatbuffers::FlatBufferBuilder flatbuffer_builder;
+  auto cpu_settings =
+      tflite::CreateCPUSettings(flatbuffer_builder, num_threads);
+  auto caching_settings = tflite::CreateCompilationCachingSettingsDirect(
+      flatbuffer_builder, cache_dir.c_str());
+  TFLiteSettingsBuilder tflite_settings_builder(flatbuffer_builder);
+  tflite_settings_builder.add_cpu_settings(cpu_settings);
+  tflite_settings_builder.add_compilation_caching_settings(caching_settings);
+  flatbuffer_builder.Finish(tflite_settings_builder.Finish());
+  const TFLiteSettings *settings = flatbuffers::GetRoot<TFLiteSettings>(
+      flatbuffer_builder.GetBufferPointer());
+  return stable_delegate_handle->delegate_plugin->create(settings);
+}
+
+// Runs the add test model once with delegate applied.
+TfLiteStatus InvokeAddModel(TfLiteOpaqueDelegate *delegate) {
+  TfLiteModel *model =
+      TfLiteModelCreateFromFile("tensorflow/lite/testdata/add.bin");
+  if (model == nullptr) return kTfLiteError;
+  TfLiteInterpreterOptions *options = TfLiteInterpreterOptionsCreate();
+  TfLiteInterpreterOptionsAddDelegate(options, delegate);
+  TfLiteInterpreter *interpreter = TfLiteInterpreterCreate(model, options);
+  TfLiteInterpreterOptionsDelete(options);
+  TfLiteStatus status = interpreter != nullptr
+                            ? TfLiteInterpreterAllocateTensors(interpreter)
+                            : kTfLiteError;
+  if (status == kTfLiteOk) status = TfLiteInterpreterInvoke(interpreter);
+  if (interpreter != nullptr) TfLiteInterpreterDelete(interpreter);
+  TfLiteModelDelete(model);
+  return status;
+}
+
+int CountBlobs(const std::filesystem::path &cache_dir) {
+  int blobs = 0;
+  for (const auto &entry : std::filesystem::directory_iterator(cache_dir))
+    blobs += entry.path().extension() == ".blob";
+  return blobs;
+}
+
+TEST_F(OpenVINODelegateExternalTest, CreateWithCpuAndCachingSettings) {
+  stable_delegate_handle = LoadDelegateFromSharedLibrary(
+      "bazel-bin/delegate/intel_openvino/"
+      "libtensorflowlite_intel_openvino_delegate.so");
+  ASSERT_NE(stable_delegate_handle, nullptr);
+  const std::filesystem::path cache_dir =
+      std::filesystem::path(testing::TempDir()) / "external_settings_cache";
+  std::filesystem::remove_all(cache_dir);
+
+  // The partition compiled with the cache dir of the settings lands there.
+  TfLiteOpaqueDelegate *opaque_delegate =
+      CreateWithSettings(stable_delegate_handle, 2, cache_dir.string());
+  ASSERT_NE(opaque_delegate, nullptr);
+  EXPECT_EQ(kTfLiteOk, InvokeAddModel(opaque_delegate));
+  stable_delegate_handle->delegate_plugin->destroy(opaque_delegate);
+  ASSERT_TRUE(std::filesystem::exists(cache_dir));
+  EXPECT_EQ(1, CountBlobs(cache_dir));
+
+  // Same settings, the blob is reused.
+  opaque_delegate =
+      CreateWithSettings(stable_delegate_handle, 2, cache_dir.string());
+  ASSERT_NE(opaque_delegate, nullptr);
+  EXPECT_EQ(kTfLiteOk, InvokeAddModel(opaque_delegate));
+  stable_delegate_handle->delegate_plugin->destroy(opaque_delegate);
+  EXPECT_EQ(1, CountBlobs(cache_dir));
+
+  // The thread count is part of the compile properties the cache key covers,
+  // so another one compiles and stores the partition anew.
+  opaque_delegate =
+      CreateWithSettings(stable_delegate_handle, 1, cache_dir.string());
+  ASSERT_NE(opaque_delegate, nullptr);
+  EXPECT_EQ(kTfLiteOk, InvokeAddModel(opaque_delegate));
+  stable_delegate_handle->delegate_plugin->destroy(opaque_delegate);
+  EXPECT_EQ(2, CountBlobs(cache_dir));
+  std::filesystem::remove_all(cache_dir);
+}
+
 }  // namespace
@@ -29,44 +29,21 @@ TfLiteStatus OpenVINODelegateKernel::Init(
 TfLiteStatus OpenVINODelegateKernel::Prepare(TfLiteOpaqueContext *context,
                                              TfLiteOpaqueNode *node) {
   TFLITE_LOG(INFO) << "inside Prepare \n";
-  return kTfLiteOk;
+  return ov_delegate_core_->PrepareShapes(context);
 }
 
 TfLiteStatus OpenVINODelegateKernel::Eval(TfLiteOpaqueContext *context,
                                           TfLiteOpaqueNode *node) {
-  TFLITE_LOG(INFO) << "inside Eval\n";
-  std::vector<int> compute_inputs = ov_delegate_core_->getComputeInputs();
-  size_t i = 0;
-  for (int t : compute_inputs) {
-    ov::Tensor inputBlob =
-        ov_delegate_core_->getInferRequest().get_input_tensor(i++);
-    uint8_t *dest = (uint8_t *)inputBlob.data<float>();
-
-    const TfLiteOpaqueTensor *opaque_input_tensor =
-        TfLiteOpaqueContextGetOpaqueTensor(context, t);
-    auto len = TfLiteOpaqueTensorByteSize(opaque_input_tensor);
-    void *srcPtr = TfLiteOpaqueTensorData(opaque_input_tensor);
-
-    std::memcpy((uint8_t *)dest, (uint8_t *)srcPtr, len);
-  }
-  ov_delegate_core_->getInferRequest().start_async();
-  ov_delegate_core_->getInferRequest().wait_for(
-      std::chrono::milliseconds(10000));
-  std::vector<int> outputs = ov_delegate_core_->getOutputs();
-  size_t o = 0;
-  for (int t : outputs) {
-    ov::Tensor outputBlob =
-        ov_delegate_core_->getInferRequest().get_output_tensor(o);
-    const TfLiteOpaqueTensor *opaque_output_tensor =
-        TfLiteOpaqueContextGetOpaqueTensor(context, t);
-    void *srcPtr = TfLiteOpaqueTensorData(opaque_output_tensor);
-    uint8_t *dest = (uint8_t *)outputBlob.data<float>();
-    auto len = TfLiteOpaqueTensorByteSize(opaque_output_tensor);
-    std::memcpy((void *)srcPtr, (void *)dest, len);
-    o++;
-  }
-
-  return kTfLiteOk;
+  // Hot path, must neither allocate nor log once compiled.
+  if (ov_delegate_core_->isBatched())
+    return ov_delegate_core_->InferBatched(context);
+  if (ov_delegate_core_->WaitForCompiledModel() != kTfLiteOk ||
+      ov_delegate_core_->BindTensors(context) != kTfLiteOk)
+    return kTfLiteError;
+  if (ov_delegate_core_->isAsync())
+    return ov_delegate_core_->StartInfer(context);
+  if (ov_delegate_core_->Infer() != kTfLiteOk) return kTfLiteError;
+  return ov_delegate_core_->FetchOutputs(context);
 }
 
 }  // namespace openvinodelegate
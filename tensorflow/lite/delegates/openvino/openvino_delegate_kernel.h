@@ -22,8 +22,18 @@ namespace tflite {
 namespace openvinodelegate {
 class OpenVINODelegateKernel : public SimpleOpaqueDelegateKernelInterface {
  public:
-  explicit OpenVINODelegateKernel()
-      : ov_delegate_core_(std::make_unique<OpenVINODelegateCore>("")) {}
+  // Passing a compile_pool makes Init return once the model is built, the
+  // first Eval waits for its compilation unless settings.tiered_compilation
+  // lets it run on a fast tier meanwhile.
+  explicit OpenVINODelegateKernel(
+      std::shared_ptr<OpenVINOModelCache> model_cache = nullptr,
+      std::shared_ptr<OpenVINOCompiledPartitions> compiled_partitions = nullptr,
+      std::shared_ptr<OpenVINOCompilePool> compile_pool = nullptr,
+      OpenVINOKernelSettings settings = {}, std::string_view plugins_path = "")
+      : ov_delegate_core_(std::make_unique<OpenVINODelegateCore>(
+            plugins_path, std::move(model_cache),
+            std::move(compiled_partitions), std::move(compile_pool),
+            std::move(settings))) {}
 
   TfLiteStatus Init(TfLiteOpaqueContext *context,
                     const TfLiteOpaqueDelegateParams *params) override;
@@ -7,6 +7,9 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <filesystem>
+#include <fstream>
+
 #include "tensorflow/lite/builtin_ops.h"
 #include "tensorflow/lite/c/c_api.h"
 #include "tensorflow/lite/core/kernels/builtin_op_kernels.h"
@@ -106,7 +109,8 @@ class OpenVINODelegateTest : public testing::Test {
 TEST_F(OpenVINODelegateTest, CheckSupportedInputsTypeTest) {
   auto test_func = [](TfLiteOpaqueContext *opaque_context,
                       TfLiteOpaqueNode *node) -> void {
-    TfLiteOpenVINODelegateOptions options_del;
+    TfLiteOpenVINODelegateOptions options_del =
+        TfLiteOpenVINODelegateOptionsDefault();
 
     tflite::openvinodelegate::OpenVINODelegate ov_del_test =
         tflite::openvinodelegate::OpenVINODelegate(&options_del);
@@ -121,7 +125,8 @@ TEST_F(OpenVINODelegateTest, CheckSupportedInputsTypeTest) {
 TEST_F(OpenVINODelegateTest, CheckUnsupportedInputsTypeTest) {
   auto test_func = [](TfLiteOpaqueContext *opaque_context,
                       TfLiteOpaqueNode *node) -> void {
-    TfLiteOpenVINODelegateOptions options_del;
+    TfLiteOpenVINODelegateOptions options_del =
+        TfLiteOpenVINODelegateOptionsDefault();
     tflite::openvinodelegate::OpenVINODelegate ov_del_test =
         tflite::openvinodelegate::OpenVINODelegate(&options_del);
     tflite::openvinodelegate::OpenVINODelegateTestPeer test_peer;
@@ -135,7 +140,8 @@ TEST_F(OpenVINODelegateTest, CheckUnsupportedInputsTypeTest) {
 TEST_F(OpenVINODelegateTest, CheckUnsupportedInputsTypeTest2) {
   auto test_func = [](TfLiteOpaqueContext *opaque_context,
                       TfLiteOpaqueNode *node) -> void {
-    TfLiteOpenVINODelegateOptions options_del;
+    TfLiteOpenVINODelegateOptions options_del =
+        TfLiteOpenVINODelegateOptionsDefault();
     tflite::openvinodelegate::OpenVINODelegate ov_del_test =
         tflite::openvinodelegate::OpenVINODelegate(&options_del);
     tflite::openvinodelegate::OpenVINODelegateTestPeer test_peer;
@@ -149,7 +155,8 @@ TEST_F(OpenVINODelegateTest, CheckUnsupportedInputsTypeTest2) {
 TEST_F(OpenVINODelegateTest, CheckSupportedInputsTypeTest2) {
   auto test_func = [](TfLiteOpaqueContext *opaque_context,
                       TfLiteOpaqueNode *node) -> void {
-    TfLiteOpenVINODelegateOptions options_del;
+    TfLiteOpenVINODelegateOptions options_del =
+        TfLiteOpenVINODelegateOptionsDefault();
     tflite::openvinodelegate::OpenVINODelegate ov_del_test =
         tflite::openvinodelegate::OpenVINODelegate(&options_del);
     tflite::openvinodelegate::OpenVINODelegateTestPeer test_peer;
@@ -163,7 +170,8 @@ TEST_F(OpenVINODelegateTest, CheckSupportedInputsTypeTest2) {
 TEST_F(OpenVINODelegateTest, CheckInputsIsNodeSupportedByDelegate1) {
   auto test_func = [](TfLiteOpaqueContext *opaque_context,
                       TfLiteOpaqueNode *node) -> void {
-    TfLiteOpenVINODelegateOptions options_del;
+    TfLiteOpenVINODelegateOptions options_del =
+        TfLiteOpenVINODelegateOptionsDefault();
     tflite::openvinodelegate::OpenVINODelegate ov_del_test =
         tflite::openvinodelegate::OpenVINODelegate(&options_del);
     EXPECT_EQ(false, ov_del_test.IsNodeSupportedByDelegate(nullptr, node,
@@ -175,7 +183,8 @@ TEST_F(OpenVINODelegateTest, CheckInputsIsNodeSupportedByDelegate1) {
 TEST_F(OpenVINODelegateTest, CheckInputsSupportedByDelegate2) {
   auto test_func = [](TfLiteOpaqueContext *opaque_context,
                       TfLiteOpaqueNode *node) -> void {
-    TfLiteOpenVINODelegateOptions options_del;
+    TfLiteOpenVINODelegateOptions options_del =
+        TfLiteOpenVINODelegateOptionsDefault();
     tflite::openvinodelegate::OpenVINODelegate ov_del_test =
         tflite::openvinodelegate::OpenVINODelegate(&options_del);
     EXPECT_EQ(false, ov_del_test.IsNodeSupportedByDelegate(nullptr, nullptr,
@@ -187,7 +196,8 @@ TEST_F(OpenVINODelegateTest, CheckInputsSupportedByDelegate2) {
 TEST_F(OpenVINODelegateTest, CheckInputsSupportedByDelegate3) {
   auto test_func = [](TfLiteOpaqueContext *opaque_context,
                       TfLiteOpaqueNode *node) -> void {
-    TfLiteOpenVINODelegateOptions options_del;
+    TfLiteOpenVINODelegateOptions options_del =
+        TfLiteOpenVINODelegateOptionsDefault();
     tflite::openvinodelegate::OpenVINODelegate ov_del_test =
         tflite::openvinodelegate::OpenVINODelegate(&options_del);
     EXPECT_EQ(false,
@@ -199,7 +209,8 @@ TEST_F(OpenVINODelegateTest, CheckInputsSupportedByDelegate3) {
 TEST_F(OpenVINODelegateTest, CheckNoSupportedTypes) {
   auto test_func = [](TfLiteOpaqueContext *opaque_context,
                       TfLiteOpaqueNode *node) -> void {
-    TfLiteOpenVINODelegateOptions options_del;
+    TfLiteOpenVINODelegateOptions options_del =
+        TfLiteOpenVINODelegateOptionsDefault();
     tflite::openvinodelegate::OpenVINODelegate ov_del_test =
         tflite::openvinodelegate::OpenVINODelegate(&options_del);
     tflite::openvinodelegate::OpenVINODelegateTestPeer test_peer;
@@ -212,7 +223,8 @@ TEST_F(OpenVINODelegateTest, CheckNoSupportedTypes) {
 TEST_F(OpenVINODelegateTest, CheckDimsTest) {
   auto test_func = [](TfLiteOpaqueContext *opaque_context,
                       TfLiteOpaqueNode *node) -> void {
-    TfLiteOpenVINODelegateOptions options_del;
+    TfLiteOpenVINODelegateOptions options_del =
+        TfLiteOpenVINODelegateOptionsDefault();
     tflite::openvinodelegate::OpenVINODelegate ov_del_test =
         tflite::openvinodelegate::OpenVINODelegate(&options_del);
     tflite::openvinodelegate::OpenVINODelegateTestPeer test_peer;
@@ -225,7 +237,8 @@ TEST_F(OpenVINODelegateTest, CheckDimsTest) {
 TEST_F(OpenVINODelegateTest, CheckDimsDynamicTest) {
   auto test_func = [](TfLiteOpaqueContext *opaque_context,
                       TfLiteOpaqueNode *node) -> void {
-    TfLiteOpenVINODelegateOptions options_del;
+    TfLiteOpenVINODelegateOptions options_del =
+        TfLiteOpenVINODelegateOptionsDefault();
     tflite::openvinodelegate::OpenVINODelegate ov_del_test =
         tflite::openvinodelegate::OpenVINODelegate(&options_del);
     tflite::openvinodelegate::OpenVINODelegateTestPeer test_peer;
@@ -234,3 +247,106 @@ TEST_F(OpenVINODelegateTest, CheckDimsDynamicTest) {
   };
   setup_delegate(test_func);
 }
+
+// Runs the add test model once with delegate applied.
+static TfLiteStatus InvokeAddModel(TfLiteOpaqueDelegate *delegate) {
+  TfLiteModel *model =
+      TfLiteModelCreateFromFile("tensorflow/lite/testdata/add.bin");
+  if (model == nullptr) return kTfLiteError;
+  TfLiteInterpreterOptions *options = TfLiteInterpreterOptionsCreate();
+  TfLiteInterpreterOptionsAddDelegate(options, delegate);
+  TfLiteInterpreter *interpreter = TfLiteInterpreterCreate(model, options);
+  TfLiteInterpreterOptionsDelete(options);
+  TfLiteStatus status = interpreter != nullptr
+                            ? TfLiteInterpreterAllocateTensors(interpreter)
+                            : kTfLiteError;
+  if (status == kTfLiteOk) status = TfLiteInterpreterInvoke(interpreter);
+  if (interpreter != nullptr) TfLiteInterpreterDelete(interpreter);
+  TfLiteModelDelete(model);
+  return status;
+}
+
+TEST(OpenVINODelegateCompilationTest, ReadyWithoutPartitions) {
+  TfLiteOpenVINODelegateOptions options =
+      TfLiteOpenVINODelegateOptionsDefault();
+  options.async_compilation = true;
+  options.tiered_compilation = true;
+  TfLiteOpaqueDelegate *delegate = TfLiteCreateOpenVINODelegate(&options);
+  ASSERT_NE(delegate, nullptr);
+
+  bool ready = false;
+  EXPECT_EQ(kTfLiteOk, TfLiteOpenVINODelegateIsReady(delegate, &ready));
+  EXPECT_TRUE(ready);
+  EXPECT_EQ(kTfLiteOk, TfLiteOpenVINODelegateWaitUntilReady(delegate, 0));
+
+  uint64_t fast_tier_invocations = 1, optimized_tier_invocations = 1;
+  int64_t tier_switch_ms = 0;
+  EXPECT_EQ(kTfLiteOk, TfLiteOpenVINODelegateGetTierStats(
+                           delegate, &fast_tier_invocations,
+                           &optimized_tier_invocations, &tier_switch_ms));
+  EXPECT_EQ(0, fast_tier_invocations);
+  EXPECT_EQ(0, optimized_tier_invocations);
+  EXPECT_EQ(-1, tier_switch_ms);
+  tflite::TfLiteOpaqueDelegateFactory::DeleteSimpleDelegate(delegate);
+}
+
+TEST(OpenVINODelegateCompilationTest, RecompilesCorruptCachedBlob) {
+  const std::filesystem::path cache_dir =
+      std::filesystem::path(testing::TempDir()) / "corrupt_blob_cache";
+  std::filesystem::remove_all(cache_dir);
+  const std::string cache_dir_string = cache_dir.string();
+  TfLiteOpenVINODelegateOptions options =
+      TfLiteOpenVINODelegateOptionsDefault();
+  options.cache_dir = cache_dir_string.c_str();
+  options.async_compilation = true;
+
+  TfLiteOpaqueDelegate *delegate = TfLiteCreateOpenVINODelegate(&options);
+  ASSERT_NE(delegate, nullptr);
+  EXPECT_EQ(kTfLiteOk, InvokeAddModel(delegate));
+  tflite::TfLiteOpaqueDelegateFactory::DeleteSimpleDelegate(delegate);
+
+  // The blob is still found by the next delegate, but cannot be imported.
+  int corrupted = 0;
+  for (const auto &entry : std::filesystem::directory_iterator(cache_dir)) {
+    if (entry.path().extension() != ".blob") continue;
+    std::ofstream(entry.path(), std::ios::binary | std::ios::trunc)
+        << "corrupt";
+    corrupted++;
+  }
+  ASSERT_GT(corrupted, 0);
+
+  delegate = TfLiteCreateOpenVINODelegate(&options);
+  ASSERT_NE(delegate, nullptr);
+  EXPECT_EQ(kTfLiteOk, InvokeAddModel(delegate));
+  EXPECT_EQ(kTfLiteOk, InvokeAddModel(delegate));
+  tflite::TfLiteOpaqueDelegateFactory::DeleteSimpleDelegate(delegate);
+  std::filesystem::remove_all(cache_dir);
+}
+
+TEST(OpenVINODelegateCompilationTest, ExportsAfterAsyncCompilation) {
+  const std::string container =
+      (std::filesystem::path(testing::TempDir()) / "async_export.ovc")
+          .string();
+  std::filesystem::remove(container);
+  TfLiteOpenVINODelegateOptions options =
+      TfLiteOpenVINODelegateOptionsDefault();
+  options.async_compilation = true;
+
+  TfLiteOpaqueDelegate *delegate = TfLiteCreateOpenVINODelegate(&options);
+  ASSERT_NE(delegate, nullptr);
+  EXPECT_EQ(kTfLiteOk, InvokeAddModel(delegate));
+  EXPECT_EQ(kTfLiteOk, TfLiteOpenVINODelegateExportCompiledModel(
+                           delegate, container.c_str()));
+  tflite::TfLiteOpaqueDelegateFactory::DeleteSimpleDelegate(delegate);
+
+  ASSERT_TRUE(std::filesystem::exists(container));
+  EXPECT_GT(std::filesystem::file_size(container), 0);
+
+  options = TfLiteOpenVINODelegateOptionsDefault();
+  options.precompiled_model_path = container.c_str();
+  delegate = TfLiteCreateOpenVINODelegate(&options);
+  ASSERT_NE(delegate, nullptr);
+  EXPECT_EQ(kTfLiteOk, InvokeAddModel(delegate));
+  tflite::TfLiteOpaqueDelegateFactory::DeleteSimpleDelegate(delegate);
+  std::filesystem::remove(container);
+}
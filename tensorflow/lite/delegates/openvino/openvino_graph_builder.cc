@@ -4,9 +4,36 @@
 
 #include "openvino_graph_builder.h"
 
+#include <algorithm>
+#include <cstring>
+#include <string_view>
+
 namespace tflite {
 namespace openvinodelegate {
 
+size_t OpenVINOGraphBuilder::HashConstant(const void *data, size_t size) {
+  // Only the leading bytes are hashed, candidates are compared in full.
+  constexpr size_t kHashedBytes = 256;
+  return std::hash<std::string_view>()(std::string_view(
+             static_cast<const char *>(data), std::min(size, kHashedBytes))) ^
+         size;
+}
+
+std::shared_ptr<ov::opset8::Constant> OpenVINOGraphBuilder::FindConstant(
+    const ov::element::Type &type, const ov::Shape &shape, const void *data,
+    size_t size) const {
+  auto range = constants_.equal_range(HashConstant(data, size));
+  for (auto it = range.first; it != range.second; ++it) {
+    const std::shared_ptr<ov::opset8::Constant> &constant = it->second;
+    if (constant->get_element_type() == type &&
+        constant->get_shape() == shape &&
+        constant->get_byte_size() == size &&
+        std::memcmp(constant->get_data_ptr(), data, size) == 0)
+      return constant;
+  }
+  return nullptr;
+}
+
 TfLiteStatus OpenVINOGraphBuilder::CreateNodeFromTfLiteOp(
     int node_id, TfLiteRegistrationExternal *registration,
     TfLiteOpaqueNode *node, TfLiteOpaqueContext *context) {
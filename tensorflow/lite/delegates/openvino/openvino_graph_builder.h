@@ -7,6 +7,7 @@
 #include <openvino/openvino.hpp>
 #include <openvino/opsets/opset3.hpp>
 #include <openvino/opsets/opset8.hpp>
+#include <unordered_map>
 #include <vector>
 
 #include "delegate/intel_openvino/operations/include/add.h"
@@ -38,8 +39,15 @@ namespace openvinodelegate {
 
 class OpenVINOGraphBuilder {
  public:
-  OpenVINOGraphBuilder(std::unique_ptr<NodeManager> node_manager) {
+  // With share_constants, constants alias the kTfLiteMmapRo tensor data
+  // instead of copying it, which must then outlive the model and the models
+  // compiled from it.
+  OpenVINOGraphBuilder(std::unique_ptr<NodeManager> node_manager,
+                       bool share_constants = false)
+      : share_constants_(share_constants) {
     node_manager_ = std::move(node_manager);
+    // Folding the layout conversions of shared weights would copy them.
+    node_manager_->setFoldConstants(!share_constants);
   }
 
   TfLiteStatus convertNHWCtoNCHW(std::vector<int> node_dims,
@@ -72,7 +80,24 @@ class OpenVINOGraphBuilder {
     return kTfLiteOk;
   }
 
-  TfLiteStatus AddInputParams(const TfLiteOpaqueTensor *t, const int index) {
+  // Shape of the Parameter of input t. With dynamic_shapes every axis but
+  // the innermost one, i.e. batch and spatial axes, is left dynamic so that
+  // the compiled model accepts resized inputs.
+  static ov::PartialShape GetInputShape(const TfLiteOpaqueTensor *t,
+                                        bool dynamic_shapes) {
+    int32_t num_dims = TfLiteOpaqueTensorNumDims(t);
+    ov::PartialShape shape;
+    for (int i = 0; i < num_dims; i++) {
+      if (dynamic_shapes && i < num_dims - 1)
+        shape.push_back(ov::Dimension::dynamic());
+      else
+        shape.push_back(TfLiteOpaqueTensorDim(t, i));
+    }
+    return shape;
+  }
+
+  TfLiteStatus AddInputParams(const TfLiteOpaqueTensor *t, const int index,
+                              bool dynamic_shapes = false) {
     if (t == nullptr) return kTfLiteError;
     if (index < 0) return kTfLiteError;
 
@@ -85,14 +110,24 @@ class OpenVINOGraphBuilder {
     if (dims.size() <= 0) return kTfLiteError;
 
     auto input = std::make_shared<ov::opset3::Parameter>(
-        ov::element::f32, ov::Shape(dims.begin(), dims.end()));
+        ov::element::f32, GetInputShape(t, dynamic_shapes));
     if (input == NULL) {
       return kTfLiteError;
     }
     input_params_.push_back(input);
 
-    std::shared_ptr<ov::Node> interim;
-    if (convertNHWCtoNCHW(dims, input, interim) != kTfLiteOk)
+    std::shared_ptr<ov::Node> interim = input;
+    if (dynamic_shapes && dims.size() < 4) {
+      // The Reshape of convertNHWCtoNCHW fixes every axis, prepending unit
+      // axes keeps the dynamic ones.
+      std::vector<int64_t> axes(4 - dims.size());
+      for (size_t i = 0; i < axes.size(); i++) axes[i] = i;
+      interim = std::make_shared<ov::opset8::Unsqueeze>(
+          input, std::make_shared<ov::opset8::Constant>(
+                     ov::element::i64, ov::Shape{axes.size()}, axes));
+      dims.insert(dims.begin(), axes.size(), 1);
+    }
+    if (convertNHWCtoNCHW(dims, interim, interim) != kTfLiteOk)
       return kTfLiteError;
     if (interim == nullptr) return kTfLiteError;
     node_manager_->setOutputAtOperandIndex(index, interim);
@@ -101,9 +136,13 @@ class OpenVINOGraphBuilder {
     return kTfLiteOk;
   }
 
+  // Materializes constant tensor index once, however many nodes consume it,
+  // and reuses the Constant of an earlier tensor with the same content.
   TfLiteStatus CreateConstNode(const TfLiteOpaqueContext *context,
                                const int index) {
     if (context == nullptr) return kTfLiteError;
+    if (index >= 0 && node_manager_->hasOutputAtOperandIndex(index))
+      return kTfLiteOk;
     const TfLiteOpaqueTensor *t =
         TfLiteOpaqueContextGetOpaqueTensor(context, index);
     int32_t num_dims;
@@ -168,12 +207,30 @@ class OpenVINOGraphBuilder {
         return kTfLiteError;
     }
 
-    auto const_node = std::make_shared<ov::opset8::Constant>(
-        ov_element_type, ov::Shape(dims.begin(), dims.end()), data);
+    const ov::Shape shape(dims.begin(), dims.end());
+    const size_t size = TfLiteOpaqueTensorByteSize(t);
+    constant_bytes_ += size;
+    std::shared_ptr<ov::opset8::Constant> const_node =
+        FindConstant(ov_element_type, shape, data, size);
+    if (const_node != nullptr) {
+      deduplicated_bytes_ += size;
+      node_manager_->setOutputAtOperandIndex(index, const_node);
+      return kTfLiteOk;
+    }
+    if (share_constants_) {
+      // A Constant over a tensor shares its memory, the tensor does not own
+      // the TFLite buffer either.
+      const_node = std::make_shared<ov::opset8::Constant>(
+          ov::Tensor(ov_element_type, shape, const_cast<void *>(data)));
+    } else {
+      const_node =
+          std::make_shared<ov::opset8::Constant>(ov_element_type, shape, data);
+    }
     if (const_node == NULL) {
       TFLITE_LOG(INFO) << "Error in creating const node\n";
       return kTfLiteError;
     }
+    constants_.emplace(HashConstant(data, size), const_node);
     node_manager_->setOutputAtOperandIndex(index, const_node);
 
     return kTfLiteOk;
@@ -186,8 +243,7 @@ class OpenVINOGraphBuilder {
 
     for (auto o : outputs) {
       auto out_node = node_manager_->getInterimNodeOutput(o);
-      auto dims = out_node->get_shape();
-      if (dims.size() == 4) {
+      if (out_node->get_output_partial_shape(0).rank() == 4) {
         ov::AxisVector order;
         order = {0, 2, 3, 1};
         const auto order_node = std::make_shared<ov::opset8::Constant>(
@@ -215,6 +271,11 @@ class OpenVINOGraphBuilder {
 
   size_t getNodeManagerSize() const { return node_manager_->getNodeCount(); }
 
+  // Bytes of the constant tensors built, and of those that reused the
+  // Constant of an identical tensor.
+  size_t getConstantBytes() const { return constant_bytes_; }
+  size_t getDeduplicatedBytes() const { return deduplicated_bytes_; }
+
   TfLiteStatus CreateNodeFromTfLiteOp(int node_id,
                                       TfLiteRegistrationExternal *registration,
                                       TfLiteOpaqueNode *node,
@@ -224,7 +285,18 @@ class OpenVINOGraphBuilder {
                              std::shared_ptr<OperationsBase> &op_base);
 
  private:
+  static size_t HashConstant(const void *data, size_t size);
+  std::shared_ptr<ov::opset8::Constant> FindConstant(
+      const ov::element::Type &type, const ov::Shape &shape, const void *data,
+      size_t size) const;
+
   std::shared_ptr<NodeManager> node_manager_;
+  bool share_constants_;
+  // Constants built so far, by HashConstant of their content.
+  std::unordered_multimap<size_t, std::shared_ptr<ov::opset8::Constant>>
+      constants_;
+  size_t constant_bytes_ = 0;
+  size_t deduplicated_bytes_ = 0;
   std::vector<std::shared_ptr<ov::opset3::Parameter>> input_params_;
   std::vector<std::shared_ptr<ov::Node>> result_nodes_;
 };
@@ -67,6 +67,38 @@ TEST_F(OpenVINOGraphBuilderTest, AddInputParamsTest_VALID) {
   EXPECT_EQ(true, openvino_graph_builder_test->getNodeManagerSize() == 1);
 }
 
+TEST_F(OpenVINOGraphBuilderTest, AddInputParamsTest_Dynamic) {
+  TfLiteTensor t;
+  memset(&t, 0, sizeof(TfLiteTensor));
+  t.bytes = sizeof(float) * 2 * 4 * 4 * 3;
+  t.allocation_type = kTfLiteDynamic;
+  t.type = kTfLiteFloat32;
+  t.dims = TfLiteIntArrayCreate(4);
+  t.dims->data[0] = 2;
+  t.dims->data[1] = 4;
+  t.dims->data[2] = 4;
+  t.dims->data[3] = 3;
+  t.dims_signature = TfLiteIntArrayCopy(t.dims);
+
+  TfLiteOpaqueTensor *opaque_t = create_opaque_tensor(&t);
+
+  auto openvino_graph_builder_test =
+      std::make_unique<tflite::openvinodelegate::OpenVINOGraphBuilder>(
+          std::make_unique<NodeManager>());
+
+  EXPECT_EQ(kTfLiteOk, openvino_graph_builder_test->AddInputParams(
+                           opaque_t, 0, /*dynamic_shapes=*/true));
+  auto params = openvino_graph_builder_test->getInputParams();
+  ASSERT_EQ(1, params.size());
+  const ov::PartialShape &shape = params[0]->get_output_partial_shape(0);
+  EXPECT_TRUE(shape[0].is_dynamic());
+  EXPECT_TRUE(shape[1].is_dynamic());
+  EXPECT_TRUE(shape[2].is_dynamic());
+  EXPECT_EQ(3, shape[3].get_length());
+  EXPECT_TRUE(shape.compatible(ov::PartialShape{1, 8, 8, 3}));
+  EXPECT_FALSE(shape.compatible(ov::PartialShape{1, 8, 8, 4}));
+}
+
 TEST_F(OpenVINOGraphBuilderTest, AddInputParamsTest_InvalidTensor) {
   auto openvino_graph_builder_test =
       std::make_unique<tflite::openvinodelegate::OpenVINOGraphBuilder>(
@@ -0,0 +1,38 @@
+// Copyright (C) 2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#include "openvino_hash.h"
+
+#include <cstdio>
+#include <cstring>
+
+namespace tflite {
+namespace openvinodelegate {
+
+void OpenVINOHasher::Update(const void *data, size_t size) {
+  const uint8_t *bytes = static_cast<const uint8_t *>(data);
+  size_t i = 0;
+  for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t)) {
+    uint64_t word;
+    std::memcpy(&word, bytes + i, sizeof(word));
+    Mix(word);
+  }
+  if (i < size) {
+    uint64_t word = 0;
+    std::memcpy(&word, bytes + i, size - i);
+    Mix(word);
+  }
+  // Trailing zero bytes would otherwise hash like a shorter buffer.
+  Mix(size);
+}
+
+std::string OpenVINOHasher::HexDigest() const {
+  char digest[17];
+  snprintf(digest, sizeof(digest), "%016llx",
+           static_cast<unsigned long long>(getHash()));
+  return digest;
+}
+
+}  // namespace openvinodelegate
+}  // namespace tflite
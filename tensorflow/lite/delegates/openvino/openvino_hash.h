@@ -0,0 +1,64 @@
+// Copyright (C) 2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef TENSORFLOW_LITE_DELEGATES_OPENVINO_HASH_H_
+#define TENSORFLOW_LITE_DELEGATES_OPENVINO_HASH_H_
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace tflite {
+namespace openvinodelegate {
+
+// Incremental 64-bit hash of buffers that can be hundreds of megabytes, not a
+// cryptographic one. Buffers are read as 64-bit words, each word is scrambled
+// by a multiply and xor-shift finalizer before it is combined, so that every
+// bit of every word reaches every bit of the hash.
+class OpenVINOHasher {
+ public:
+  void Update(const void *data, size_t size);
+
+  template <typename T>
+  void Update(const T &value) {
+    Update(&value, sizeof(T));
+  }
+
+  void Update(const std::string &value) {
+    Update(value.size());
+    Update(value.data(), value.size());
+  }
+
+  uint64_t getHash() const { return Finalize(hash_); }
+
+  // getHash as 16 lowercase hex digits.
+  std::string HexDigest() const;
+
+  // Hash of size bytes at data alone.
+  static uint64_t Hash(const void *data, size_t size) {
+    OpenVINOHasher hasher;
+    hasher.Update(data, size);
+    return hasher.getHash();
+  }
+
+ private:
+  static uint64_t Finalize(uint64_t value) {
+    value ^= value >> 33;
+    value *= 0xff51afd7ed558ccdULL;
+    value ^= value >> 33;
+    value *= 0xc4ceb9fe1a85ec53ULL;
+    value ^= value >> 33;
+    return value;
+  }
+
+  void Mix(uint64_t value) {
+    // Finalize does not depend on hash_, only the multiply is serialized.
+    hash_ = (hash_ ^ Finalize(value)) * 0x100000001b3ULL;
+  }
+
+  uint64_t hash_ = 0xcbf29ce484222325ULL;
+};
+
+}  // namespace openvinodelegate
+}  // namespace tflite
+#endif  // TENSORFLOW_LITE_DELEGATES_OPENVINO_HASH_H_
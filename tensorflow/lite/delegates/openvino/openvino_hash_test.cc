@@ -0,0 +1,78 @@
+// Copyright (C) 2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#include "openvino_hash.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <vector>
+
+namespace tflite {
+namespace openvinodelegate {
+
+TEST(OpenVINOHasherTest, FollowsContent) {
+  std::vector<uint8_t> buffer(1003, 7);
+  const uint64_t hash = OpenVINOHasher::Hash(buffer.data(), buffer.size());
+  EXPECT_EQ(hash, OpenVINOHasher::Hash(buffer.data(), buffer.size()));
+  buffer[1001] = 8;
+  EXPECT_NE(hash, OpenVINOHasher::Hash(buffer.data(), buffer.size()));
+  buffer[1001] = 7;
+  buffer[5] = 8;
+  EXPECT_NE(hash, OpenVINOHasher::Hash(buffer.data(), buffer.size()));
+}
+
+TEST(OpenVINOHasherTest, HighBitChangesDoNotCancel) {
+  // Negating the second float of two 64-bit words only flips bit 63 of each.
+  std::vector<float> weights = {1.0f, 2.0f, 3.0f, 4.0f};
+  const size_t size = weights.size() * sizeof(float);
+  const uint64_t hash = OpenVINOHasher::Hash(weights.data(), size);
+  weights[1] = -weights[1];
+  weights[3] = -weights[3];
+  EXPECT_NE(hash, OpenVINOHasher::Hash(weights.data(), size));
+
+  std::vector<uint64_t> words(16, 0);
+  const uint64_t zeros =
+      OpenVINOHasher::Hash(words.data(), words.size() * sizeof(uint64_t));
+  for (size_t i = 0; i < words.size(); i++) {
+    for (size_t j = i + 1; j < words.size(); j++) {
+      words[i] = words[j] = 1ULL << 63;
+      EXPECT_NE(zeros, OpenVINOHasher::Hash(words.data(),
+                                            words.size() * sizeof(uint64_t)));
+      words[i] = words[j] = 0;
+    }
+  }
+}
+
+TEST(OpenVINOHasherTest, SpreadsEverySingleBitChange) {
+  std::vector<uint8_t> buffer(64, 0);
+  const uint64_t hash = OpenVINOHasher::Hash(buffer.data(), buffer.size());
+  for (size_t bit = 0; bit < buffer.size() * 8; bit++) {
+    buffer[bit / 8] ^= 1 << (bit % 8);
+    const uint64_t changed = hash ^
+                             OpenVINOHasher::Hash(buffer.data(), buffer.size());
+    buffer[bit / 8] ^= 1 << (bit % 8);
+    // About half of the hash bits flip, whichever bit of a word changed.
+    EXPECT_GT(__builtin_popcountll(changed), 12);
+    EXPECT_LT(__builtin_popcountll(changed), 52);
+  }
+}
+
+TEST(OpenVINOHasherTest, TrailingZerosChangeHash) {
+  const char data[3] = {'a', 0, 0};
+  EXPECT_NE(OpenVINOHasher::Hash(data, 1), OpenVINOHasher::Hash(data, 2));
+  EXPECT_NE(OpenVINOHasher::Hash(data, 2), OpenVINOHasher::Hash(data, 3));
+}
+
+TEST(OpenVINOHasherTest, HexDigest) {
+  OpenVINOHasher hasher;
+  hasher.Update(std::string("partition"));
+  const std::string digest = hasher.HexDigest();
+  EXPECT_EQ(16, digest.size());
+  EXPECT_EQ(std::string::npos, digest.find_first_not_of("0123456789abcdef"));
+}
+
+}  // namespace openvinodelegate
+}  // namespace tflite
@@ -0,0 +1,98 @@
+// Copyright (C) 2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#include "openvino_infer_request_pool.h"
+
+#include <algorithm>
+
+#include "tensorflow/lite/tools/logging.h"
+
+namespace tflite {
+namespace openvinodelegate {
+namespace {
+
+size_t OptimalNumberOfInferRequests(const ov::CompiledModel &compiled_model) {
+  try {
+    return std::max<uint32_t>(
+        1, compiled_model.get_property(ov::optimal_number_of_infer_requests));
+  } catch (const std::exception &) {
+    // Not reported by every plugin.
+    return 1;
+  }
+}
+
+}  // namespace
+
+OpenVINOInferRequestPool::OpenVINOInferRequestPool(
+    ov::CompiledModel compiled_model, size_t size)
+    : compiled_model_(std::move(compiled_model)),
+      size_(size != 0 ? size : OptimalNumberOfInferRequests(compiled_model_)) {
+  slots_.reserve(size_);
+  in_use_.reserve(size_);
+}
+
+std::unique_ptr<OpenVINOInferRequestPool::Slot>
+OpenVINOInferRequestPool::CreateSlot() {
+  auto slot = std::make_unique<Slot>();
+  try {
+    slot->request = compiled_model_.create_infer_request();
+  } catch (const std::exception &e) {
+    TFLITE_LOG(ERROR) << "Unable to create an infer request: " << e.what()
+                      << "\n";
+    return nullptr;
+  }
+  for (size_t i = 0; i < compiled_model_.inputs().size(); i++) {
+    ov::Tensor tensor = slot->request.get_input_tensor(i);
+    slot->inputs.push_back(Binding{tensor, nullptr, tensor.get_shape()});
+  }
+  for (size_t o = 0; o < compiled_model_.outputs().size(); o++) {
+    ov::Tensor tensor = slot->request.get_output_tensor(o);
+    slot->outputs.push_back(Binding{tensor, nullptr, tensor.get_shape()});
+  }
+  return slot;
+}
+
+OpenVINOInferRequestPool::Slot *OpenVINOInferRequestPool::Acquire(
+    size_t &index) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    if (index < slots_.size() && !in_use_[index]) break;
+    auto free_slot = std::find(in_use_.begin(), in_use_.end(), false);
+    if (free_slot != in_use_.end()) {
+      index = free_slot - in_use_.begin();
+      break;
+    }
+    if (slots_.size() < size_) {
+      std::unique_ptr<Slot> slot = CreateSlot();
+      if (slot == nullptr) return nullptr;
+      index = slots_.size();
+      slots_.push_back(std::move(slot));
+      in_use_.push_back(false);
+      break;
+    }
+    released_.wait(lock);
+  }
+  if (slots_[index] == nullptr) {
+    slots_[index] = CreateSlot();
+    if (slots_[index] == nullptr) return nullptr;
+  }
+  in_use_[index] = true;
+  return slots_[index].get();
+}
+
+void OpenVINOInferRequestPool::Release(size_t index, bool finished) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!finished) {
+      TFLITE_LOG(WARN) << "Retiring infer request " << index
+                       << ", it is still running\n";
+      retired_.push_back(std::move(slots_[index]));
+    }
+    in_use_[index] = false;
+  }
+  released_.notify_one();
+}
+
+}  // namespace openvinodelegate
+}  // namespace tflite
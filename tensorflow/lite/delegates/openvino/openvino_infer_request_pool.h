@@ -0,0 +1,86 @@
+// Copyright (C) 2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef TENSORFLOW_LITE_DELEGATES_OPENVINO_INFER_REQUEST_POOL_H_
+#define TENSORFLOW_LITE_DELEGATES_OPENVINO_INFER_REQUEST_POOL_H_
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <openvino/openvino.hpp>
+#include <openvino/runtime/core.hpp>
+#include <vector>
+
+namespace tflite {
+namespace openvinodelegate {
+
+// Infer requests of one compiled model. The kernels of every interpreter
+// running the same partition share the pool, so that they infer
+// concurrently, e.g. on the streams of a THROUGHPUT configuration, with a
+// single copy of the weights. Requests are created on demand up to the size
+// of the pool; once all of them are taken, Acquire waits for one.
+class OpenVINOInferRequestPool {
+ public:
+  // Tensor the request created for a model input or output, and the TFLite
+  // buffer bound to the request in its place, null when fed or read by copy.
+  // shape is the one of tensor, kept to be compared without allocating when
+  // the model has dynamic inputs. source is the TFLite buffer an input was
+  // last copied from into tensor, with the checksum of its content for
+  // inputs tracked by one, null once tensor was written otherwise.
+  struct Binding {
+    ov::Tensor tensor;
+    void *bound = nullptr;
+    ov::Shape shape;
+    const void *source = nullptr;
+    uint64_t checksum = 0;
+  };
+
+  struct Slot {
+    ov::InferRequest request;
+    std::vector<Binding> inputs;
+    std::vector<Binding> outputs;
+    // Whether request carries the completion callback of an asynchronous
+    // inference, to be cleared before it runs synchronously.
+    bool callback_set = false;
+  };
+
+  // size of 0 takes ov::optimal_number_of_infer_requests of compiled_model.
+  OpenVINOInferRequestPool(ov::CompiledModel compiled_model, size_t size);
+
+  // Takes a free request, preferably the one at index, which is updated to
+  // the request taken. Returns null if a request cannot be created. Does not
+  // allocate once the preferred request exists.
+  Slot *Acquire(size_t &index);
+
+  // Hands the request at index back. A request that has not finished, e.g.
+  // one that timed out and could not be cancelled, is retired instead of
+  // being handed out again while running, the next Acquire of index creates
+  // a new one.
+  void Release(size_t index, bool finished = true);
+
+  size_t getSize() const { return size_; }
+
+  size_t getCreatedCount() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return slots_.size();
+  }
+
+ private:
+  std::unique_ptr<Slot> CreateSlot();
+
+  ov::CompiledModel compiled_model_;
+  size_t size_;
+  std::mutex mutex_;
+  std::condition_variable released_;
+  // Null for a retired request until the next Acquire of its index.
+  std::vector<std::unique_ptr<Slot>> slots_;
+  std::vector<bool> in_use_;
+  // Requests retired by Release, destroyed with the pool as destroying a
+  // running request waits for it.
+  std::vector<std::unique_ptr<Slot>> retired_;
+};
+
+}  // namespace openvinodelegate
+}  // namespace tflite
+#endif  // TENSORFLOW_LITE_DELEGATES_OPENVINO_INFER_REQUEST_POOL_H_
@@ -0,0 +1,85 @@
+// Copyright (C) 2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#include "openvino_infer_request_pool.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <future>
+
+#include "openvino_test_model.h"
+
+namespace tflite {
+namespace openvinodelegate {
+
+class OpenVINOInferRequestPoolTest : public OpenVINOCompiledModelTest {};
+
+TEST_F(OpenVINOInferRequestPoolTest, SizedFromCompiledModel) {
+  OpenVINOInferRequestPool pool(compiled_model_, 0);
+  EXPECT_EQ(pool.getSize(),
+            compiled_model_.get_property(ov::optimal_number_of_infer_requests));
+  EXPECT_EQ(pool.getCreatedCount(), 0);
+}
+
+TEST_F(OpenVINOInferRequestPoolTest, CollectsRequestTensors) {
+  OpenVINOInferRequestPool pool(compiled_model_, 1);
+  size_t index = 0;
+  OpenVINOInferRequestPool::Slot *slot = pool.Acquire(index);
+  ASSERT_NE(slot, nullptr);
+  ASSERT_EQ(slot->inputs.size(), 1);
+  ASSERT_EQ(slot->outputs.size(), 1);
+  EXPECT_EQ(slot->inputs[0].tensor.get_byte_size(), 4 * sizeof(float));
+  EXPECT_EQ(slot->outputs[0].bound, nullptr);
+}
+
+TEST_F(OpenVINOInferRequestPoolTest, PrefersGivenRequest) {
+  OpenVINOInferRequestPool pool(compiled_model_, 2);
+  size_t first = 0, second = 0;
+  pool.Acquire(first);
+  pool.Acquire(second);
+  EXPECT_EQ(first, 0);
+  EXPECT_EQ(second, 1);
+  pool.Release(first);
+  pool.Release(second);
+
+  size_t preferred = 1;
+  pool.Acquire(preferred);
+  EXPECT_EQ(preferred, 1);
+  EXPECT_EQ(pool.getCreatedCount(), 2);
+}
+
+TEST_F(OpenVINOInferRequestPoolTest, WaitsForReleasedRequest) {
+  OpenVINOInferRequestPool pool(compiled_model_, 1);
+  size_t index = 0;
+  pool.Acquire(index);
+  auto waiting = std::async(std::launch::async, [&pool] {
+    size_t other = 0;
+    return pool.Acquire(other) != nullptr;
+  });
+  EXPECT_EQ(waiting.wait_for(std::chrono::milliseconds(50)),
+            std::future_status::timeout);
+  pool.Release(index);
+  EXPECT_TRUE(waiting.get());
+  EXPECT_EQ(pool.getCreatedCount(), 1);
+}
+
+TEST_F(OpenVINOInferRequestPoolTest, RetiresUnfinishedRequest) {
+  OpenVINOInferRequestPool pool(compiled_model_, 1);
+  size_t index = 0;
+  OpenVINOInferRequestPool::Slot *unfinished = pool.Acquire(index);
+  ASSERT_NE(unfinished, nullptr);
+  pool.Release(index, /*finished=*/false);
+
+  size_t next = 0;
+  OpenVINOInferRequestPool::Slot *slot = pool.Acquire(next);
+  ASSERT_NE(slot, nullptr);
+  EXPECT_EQ(next, index);
+  EXPECT_NE(slot, unfinished);
+  EXPECT_EQ(pool.getCreatedCount(), 1);
+}
+
+}  // namespace openvinodelegate
+}  // namespace tflite
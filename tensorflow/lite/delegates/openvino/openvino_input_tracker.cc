@@ -0,0 +1,69 @@
+// Copyright (C) 2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#include "openvino_input_tracker.h"
+
+#include <algorithm>
+#include <sstream>
+
+#include "openvino_hash.h"
+
+namespace tflite {
+namespace openvinodelegate {
+
+std::shared_ptr<OpenVINOInputTracker> OpenVINOInputTracker::Parse(
+    const std::string &static_inputs) {
+  auto tracker = std::make_shared<OpenVINOInputTracker>();
+  std::istringstream stream(static_inputs);
+  std::string item;
+  while (std::getline(stream, item, ',')) {
+    size_t end = 0;
+    int index;
+    try {
+      index = std::stoi(item, &end);
+    } catch (const std::exception &) {
+      return nullptr;
+    }
+    if (end != item.size() || index < 0) return nullptr;
+    tracker->static_inputs_.push_back(index);
+  }
+  std::sort(tracker->static_inputs_.begin(), tracker->static_inputs_.end());
+  return tracker;
+}
+
+void OpenVINOInputTracker::MarkUnchanged(int tensor_index) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (auto &[index, marks] : marked_) {
+    if (index == tensor_index) {
+      marks++;
+      return;
+    }
+  }
+  marked_.emplace_back(tensor_index, 1);
+  num_marked_ = marked_.size();
+}
+
+bool OpenVINOInputTracker::TakeUnchanged(int tensor_index, uint64_t &seen) {
+  if (num_marked_ == 0) return false;
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (const auto &[index, marks] : marked_) {
+    if (index != tensor_index) continue;
+    if (marks == seen) return false;
+    seen = marks;
+    return true;
+  }
+  return false;
+}
+
+bool OpenVINOInputTracker::IsStatic(int tensor_index) const {
+  return std::binary_search(static_inputs_.begin(), static_inputs_.end(),
+                            tensor_index);
+}
+
+uint64_t OpenVINOInputTracker::Checksum(const void *data, size_t size) {
+  return OpenVINOHasher::Hash(data, size);
+}
+
+}  // namespace openvinodelegate
+}  // namespace tflite
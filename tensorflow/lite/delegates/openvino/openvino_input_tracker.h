@@ -0,0 +1,70 @@
+// Copyright (C) 2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef TENSORFLOW_LITE_DELEGATES_OPENVINO_INPUT_TRACKER_H_
+#define TENSORFLOW_LITE_DELEGATES_OPENVINO_INPUT_TRACKER_H_
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace tflite {
+namespace openvinodelegate {
+
+// Tells the kernels of a delegate which inputs did not change since they
+// were last copied into an infer request, so that the copy can be skipped.
+// The application either marks an input unchanged before an invocation, or
+// declares it mostly static, in which case its buffer is checksummed
+// instead. Counts the input bytes copied and skipped.
+class OpenVINOInputTracker {
+ public:
+  // static_inputs holds comma separated tensor indices, e.g. "3,7". Returns
+  // null if malformed.
+  static std::shared_ptr<OpenVINOInputTracker> Parse(
+      const std::string &static_inputs);
+
+  // The next invocation of each kernel reading tensor_index may keep the
+  // copy of the previous one.
+  void MarkUnchanged(int tensor_index);
+
+  // Whether tensor_index was marked unchanged since the kernel holding seen
+  // last took its marks. seen counts the marks of tensor_index that kernel
+  // took, so that kernels sharing the tracker do not consume each other's.
+  // Does not allocate.
+  bool TakeUnchanged(int tensor_index, uint64_t &seen);
+
+  bool IsStatic(int tensor_index) const;
+
+  // OpenVINOHasher::Hash of size bytes at data, a change to any bit of the
+  // buffer changes it.
+  static uint64_t Checksum(const void *data, size_t size);
+
+  void RecordCopied(size_t bytes) {
+    bytes_copied_.fetch_add(bytes, std::memory_order_relaxed);
+  }
+  void RecordSkipped(size_t bytes) {
+    bytes_skipped_.fetch_add(bytes, std::memory_order_relaxed);
+  }
+
+  uint64_t getBytesCopied() const { return bytes_copied_; }
+  uint64_t getBytesSkipped() const { return bytes_skipped_; }
+
+ private:
+  // Sorted.
+  std::vector<int> static_inputs_;
+  std::mutex mutex_;
+  // Tensor index and number of times it was marked unchanged.
+  std::vector<std::pair<int, uint64_t>> marked_;
+  // Size of marked_, read without the lock on every invocation.
+  std::atomic<size_t> num_marked_{0};
+  std::atomic<uint64_t> bytes_copied_{0};
+  std::atomic<uint64_t> bytes_skipped_{0};
+};
+
+}  // namespace openvinodelegate
+}  // namespace tflite
+#endif  // TENSORFLOW_LITE_DELEGATES_OPENVINO_INPUT_TRACKER_H_
@@ -0,0 +1,93 @@
+// Copyright (C) 2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#include "openvino_input_tracker.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <vector>
+
+namespace tflite {
+namespace openvinodelegate {
+
+TEST(OpenVINOInputTrackerTest, ParsesStaticInputs) {
+  auto tracker = OpenVINOInputTracker::Parse("7,3");
+  ASSERT_NE(nullptr, tracker);
+  EXPECT_TRUE(tracker->IsStatic(3));
+  EXPECT_TRUE(tracker->IsStatic(7));
+  EXPECT_FALSE(tracker->IsStatic(5));
+  ASSERT_NE(nullptr, OpenVINOInputTracker::Parse(""));
+  EXPECT_FALSE(OpenVINOInputTracker::Parse("")->IsStatic(0));
+}
+
+TEST(OpenVINOInputTrackerTest, RejectsMalformedStaticInputs) {
+  EXPECT_EQ(nullptr, OpenVINOInputTracker::Parse("3,x"));
+  EXPECT_EQ(nullptr, OpenVINOInputTracker::Parse("3,,7"));
+  EXPECT_EQ(nullptr, OpenVINOInputTracker::Parse("-1"));
+  EXPECT_EQ(nullptr, OpenVINOInputTracker::Parse("2.5"));
+}
+
+TEST(OpenVINOInputTrackerTest, MarksAreTakenOnce) {
+  auto tracker = OpenVINOInputTracker::Parse("");
+  uint64_t seen = 0;
+  EXPECT_FALSE(tracker->TakeUnchanged(2, seen));
+  tracker->MarkUnchanged(2);
+  tracker->MarkUnchanged(2);
+  EXPECT_FALSE(tracker->TakeUnchanged(4, seen));
+  EXPECT_TRUE(tracker->TakeUnchanged(2, seen));
+  EXPECT_FALSE(tracker->TakeUnchanged(2, seen));
+}
+
+TEST(OpenVINOInputTrackerTest, MarksAreTakenOncePerKernel) {
+  auto tracker = OpenVINOInputTracker::Parse("");
+  uint64_t first_seen = 0, second_seen = 0;
+  tracker->MarkUnchanged(2);
+  EXPECT_TRUE(tracker->TakeUnchanged(2, first_seen));
+  EXPECT_FALSE(tracker->TakeUnchanged(2, first_seen));
+  // The first kernel taking the mark leaves it to the second one.
+  EXPECT_TRUE(tracker->TakeUnchanged(2, second_seen));
+  EXPECT_FALSE(tracker->TakeUnchanged(2, second_seen));
+  tracker->MarkUnchanged(2);
+  EXPECT_TRUE(tracker->TakeUnchanged(2, first_seen));
+  EXPECT_TRUE(tracker->TakeUnchanged(2, second_seen));
+}
+
+TEST(OpenVINOInputTrackerTest, ChecksumFollowsContent) {
+  std::vector<uint8_t> buffer(1003, 7);
+  const uint64_t checksum =
+      OpenVINOInputTracker::Checksum(buffer.data(), buffer.size());
+  EXPECT_EQ(checksum,
+            OpenVINOInputTracker::Checksum(buffer.data(), buffer.size()));
+  buffer[1001] = 8;
+  EXPECT_NE(checksum,
+            OpenVINOInputTracker::Checksum(buffer.data(), buffer.size()));
+  buffer[1001] = 7;
+  buffer[5] = 8;
+  EXPECT_NE(checksum,
+            OpenVINOInputTracker::Checksum(buffer.data(), buffer.size()));
+}
+
+TEST(OpenVINOInputTrackerTest, ChecksumFollowsSignChanges) {
+  // Flipping the signs of two mask values only changes the top bit of their
+  // 64-bit words.
+  std::vector<float> mask(16, 1.0f);
+  const size_t size = mask.size() * sizeof(float);
+  const uint64_t checksum = OpenVINOInputTracker::Checksum(mask.data(), size);
+  mask[3] = -mask[3];
+  mask[9] = -mask[9];
+  EXPECT_NE(checksum, OpenVINOInputTracker::Checksum(mask.data(), size));
+}
+
+TEST(OpenVINOInputTrackerTest, CountsBytes) {
+  auto tracker = OpenVINOInputTracker::Parse("");
+  tracker->RecordCopied(100);
+  tracker->RecordSkipped(40);
+  tracker->RecordSkipped(2);
+  EXPECT_EQ(100, tracker->getBytesCopied());
+  EXPECT_EQ(42, tracker->getBytesSkipped());
+}
+
+}  // namespace openvinodelegate
+}  // namespace tflite
@@ -0,0 +1,88 @@
+// Copyright (C) 2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#include "openvino_mapped_blob.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <istream>
+#include <openvino/core/version.hpp>
+
+#include "tensorflow/lite/tools/logging.h"
+
+namespace tflite {
+namespace openvinodelegate {
+
+MemoryStreamBuf::pos_type MemoryStreamBuf::seekoff(
+    off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which) {
+  char *target = nullptr;
+  switch (dir) {
+    case std::ios_base::beg:
+      target = eback() + off;
+      break;
+    case std::ios_base::cur:
+      target = gptr() + off;
+      break;
+    case std::ios_base::end:
+      target = egptr() + off;
+      break;
+    default:
+      return pos_type(off_type(-1));
+  }
+  if (!(which & std::ios_base::in) || target < eback() || target > egptr())
+    return pos_type(off_type(-1));
+  setg(eback(), target, egptr());
+  return pos_type(target - eback());
+}
+
+MemoryStreamBuf::pos_type MemoryStreamBuf::seekpos(
+    pos_type pos, std::ios_base::openmode which) {
+  return seekoff(off_type(pos), std::ios_base::beg, which);
+}
+
+std::shared_ptr<MappedBlob> MappedBlob::Open(const std::string &path) {
+  int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) return nullptr;
+
+  struct stat file_stat;
+  if (fstat(fd, &file_stat) != 0 || file_stat.st_size == 0) {
+    close(fd);
+    return nullptr;
+  }
+
+  void *data = mmap(nullptr, file_stat.st_size, PROT_READ, MAP_SHARED, fd, 0);
+  // The mapping keeps the file contents alive, even if the file is evicted
+  // or replaced afterwards.
+  close(fd);
+  if (data == MAP_FAILED) {
+    TFLITE_LOG(ERROR) << "Unable to map " << path << "\n";
+    return nullptr;
+  }
+  return std::shared_ptr<MappedBlob>(
+      new MappedBlob(static_cast<const char *>(data), file_stat.st_size));
+}
+
+MappedBlob::~MappedBlob() { munmap(const_cast<char *>(data_), size_); }
+
+ov::CompiledModel MappedBlob::Import(ov::Core &core, const std::string &device,
+                                     size_t offset, size_t size) const {
+#if OPENVINO_VERSION_MAJOR > 2025 || \
+    (OPENVINO_VERSION_MAJOR == 2025 && OPENVINO_VERSION_MINOR >= 2)
+  // Plugins that support it keep referencing the weights inside the tensor
+  // rather than copying them into private memory.
+  ov::Tensor blob(ov::element::u8, ov::Shape{size},
+                  const_cast<char *>(data_ + offset));
+  return core.import_model(blob, device);
+#else
+  MemoryStreamBuf buffer(data_ + offset, size);
+  std::istream stream(&buffer);
+  return core.import_model(stream, device);
+#endif
+}
+
+}  // namespace openvinodelegate
+}  // namespace tflite
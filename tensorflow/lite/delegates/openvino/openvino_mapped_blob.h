@@ -0,0 +1,55 @@
+// Copyright (C) 2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef TENSORFLOW_LITE_DELEGATES_OPENVINO_MAPPED_BLOB_H_
+#define TENSORFLOW_LITE_DELEGATES_OPENVINO_MAPPED_BLOB_H_
+#include <memory>
+#include <openvino/openvino.hpp>
+#include <openvino/runtime/core.hpp>
+#include <streambuf>
+#include <string>
+
+namespace tflite {
+namespace openvinodelegate {
+
+// Read-only view over memory that std::istream based OpenVINO APIs can consume
+// without an intermediate copy.
+class MemoryStreamBuf : public std::streambuf {
+ public:
+  MemoryStreamBuf(const char *data, size_t size) {
+    char *begin = const_cast<char *>(data);
+    setg(begin, begin, begin + size);
+  }
+
+ protected:
+  pos_type seekoff(off_type off, std::ios_base::seekdir dir,
+                   std::ios_base::openmode which) override;
+  pos_type seekpos(pos_type pos, std::ios_base::openmode which) override;
+};
+
+// Read-only, shared memory mapping of a compiled blob file. Every process
+// mapping the same file shares its pages in the page cache.
+class MappedBlob {
+ public:
+  static std::shared_ptr<MappedBlob> Open(const std::string &path);
+  ~MappedBlob();
+
+  const char *data() const { return data_; }
+  size_t size() const { return size_; }
+
+  // Imports the exported ov::CompiledModel at [offset, offset + size) of the
+  // mapping. The mapping must outlive the returned model.
+  ov::CompiledModel Import(ov::Core &core, const std::string &device,
+                           size_t offset, size_t size) const;
+
+ private:
+  MappedBlob(const char *data, size_t size) : data_(data), size_(size) {}
+
+  const char *data_;
+  size_t size_;
+};
+
+}  // namespace openvinodelegate
+}  // namespace tflite
+#endif  // TENSORFLOW_LITE_DELEGATES_OPENVINO_MAPPED_BLOB_H_
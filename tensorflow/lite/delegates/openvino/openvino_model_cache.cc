@@ -0,0 +1,274 @@
+// Copyright (C) 2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#include "openvino_model_cache.h"
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+#include "openvino_hash.h"
+#include "tensorflow/lite/builtin_ops.h"
+#include "tensorflow/lite/c/builtin_op_data.h"
+#include "tensorflow/lite/tools/logging.h"
+
+namespace tflite {
+namespace openvinodelegate {
+
+namespace {
+
+constexpr char kBlobExtension[] = ".blob";
+
+// Distinguishes the temporary files of the writers of one process.
+std::atomic<uint64_t> next_writer{0};
+
+// Size of the builtin parameter struct of every op the delegate supports, so
+// that op attributes such as strides and padding are part of the key.
+size_t BuiltinDataSize(int builtin_code) {
+  switch (builtin_code) {
+    case kTfLiteBuiltinAdd:
+      return sizeof(TfLiteAddParams);
+    case kTfLiteBuiltinAveragePool2d:
+    case kTfLiteBuiltinMaxPool2d:
+      return sizeof(TfLitePoolParams);
+    case kTfLiteBuiltinConv2d:
+      return sizeof(TfLiteConvParams);
+    case kTfLiteBuiltinConcatenation:
+      return sizeof(TfLiteConcatenationParams);
+    case kTfLiteBuiltinDepthwiseConv2d:
+      return sizeof(TfLiteDepthwiseConvParams);
+    case kTfLiteBuiltinMul:
+      return sizeof(TfLiteMulParams);
+    case kTfLiteBuiltinResizeBilinear:
+      return sizeof(TfLiteResizeBilinearParams);
+    case kTfLiteBuiltinSoftmax:
+      return sizeof(TfLiteSoftmaxParams);
+    case kTfLiteBuiltinReshape:
+      return sizeof(TfLiteReshapeParams);
+    case kTfLiteBuiltinMean:
+      return sizeof(TfLiteReducerParams);
+    case kTfLiteBuiltinTransposeConv:
+      return sizeof(TfLiteTransposeConvParams);
+    default:
+      return 0;
+  }
+}
+
+void HashTensor(TfLiteOpaqueContext *context, int index,
+                OpenVINOHasher &hasher) {
+  hasher.Update(index);
+  if (index < 0) return;
+  const TfLiteOpaqueTensor *t =
+      TfLiteOpaqueContextGetOpaqueTensor(context, index);
+  hasher.Update(static_cast<int>(TfLiteOpaqueTensorType(t)));
+  int32_t num_dims = TfLiteOpaqueTensorNumDims(t);
+  hasher.Update(num_dims);
+  for (int i = 0; i < num_dims; i++) hasher.Update(TfLiteOpaqueTensorDim(t, i));
+  if (TfLiteOpaqueTensorGetAllocationType(t) == kTfLiteMmapRo) {
+    const void *data = TfLiteOpaqueTensorData(t);
+    if (data != nullptr) hasher.Update(data, TfLiteOpaqueTensorByteSize(t));
+  }
+}
+
+}  // namespace
+
+OpenVINOModelCache::OpenVINOModelCache(std::string cache_dir,
+                                       int64_t max_size_bytes, bool use_mmap)
+    : cache_dir_(std::move(cache_dir)),
+      max_size_bytes_(max_size_bytes),
+      use_mmap_(use_mmap) {
+  std::error_code ec;
+  std::filesystem::create_directories(cache_dir_, ec);
+  if (ec) {
+    TFLITE_LOG(ERROR) << "Unable to create OpenVINO cache directory "
+                      << cache_dir_ << ": " << ec.message() << "\n";
+  }
+}
+
+std::string OpenVINOModelCache::ComputeKey(
+    TfLiteOpaqueContext *context, const TfLiteOpaqueDelegateParams *params,
+    const std::string &device, const ov::AnyMap &properties) {
+  OpenVINOHasher hasher;
+  hasher.Update(kDelegateCacheVersion);
+  hasher.Update(device);
+  for (const auto &[name, value] : properties) {
+    hasher.Update(name);
+    hasher.Update(value.as<std::string>());
+  }
+  hasher.Update(std::string(ov::get_openvino_version().buildNumber));
+
+  for (int i = 0; i < params->input_tensors->size; i++)
+    hasher.Update(params->input_tensors->data[i]);
+  for (int o = 0; o < params->output_tensors->size; o++)
+    hasher.Update(params->output_tensors->data[o]);
+
+  for (int i = 0; i < params->nodes_to_replace->size; i++) {
+    TfLiteOpaqueNode *node;
+    TfLiteRegistrationExternal *registration;
+    if (TfLiteOpaqueContextGetNodeAndRegistration(
+            context, params->nodes_to_replace->data[i], &node, &registration))
+      continue;
+
+    int builtin_code = TfLiteRegistrationExternalGetBuiltInCode(registration);
+    hasher.Update(builtin_code);
+    if (builtin_code == kTfLiteBuiltinCustom) {
+      hasher.Update(
+          std::string(TfLiteRegistrationExternalGetCustomName(registration)));
+      const void *init_data = nullptr;
+      int size = 0;
+      if (TfLiteOpaqueNodeGetCustomInitialData(node, &init_data, &size) ==
+              kTfLiteOk &&
+          init_data != nullptr)
+        hasher.Update(init_data, size);
+    } else {
+      const void *builtin_data = TfLiteOpaqueNodeGetBuiltinData(node);
+      if (builtin_data != nullptr)
+        hasher.Update(builtin_data, BuiltinDataSize(builtin_code));
+    }
+
+    const int *inputs;
+    int num_inputs;
+    if (TfLiteOpaqueNodeInputs(node, &inputs, &num_inputs) == kTfLiteOk) {
+      hasher.Update(num_inputs);
+      for (int k = 0; k < num_inputs; k++)
+        HashTensor(context, inputs[k], hasher);
+    }
+    const int *outputs;
+    int num_outputs;
+    if (TfLiteOpaqueNodeOutputs(node, &outputs, &num_outputs) == kTfLiteOk) {
+      hasher.Update(num_outputs);
+      for (int k = 0; k < num_outputs; k++)
+        HashTensor(context, outputs[k], hasher);
+    }
+  }
+  return hasher.HexDigest();
+}
+
+std::string OpenVINOModelCache::BlobPath(const std::string &key) const {
+  return (std::filesystem::path(cache_dir_) / (key + kBlobExtension)).string();
+}
+
+bool OpenVINOModelCache::Contains(const std::string &key) const {
+  std::error_code error;
+  return std::filesystem::exists(BlobPath(key), error);
+}
+
+bool OpenVINOModelCache::Load(const std::string &key, ov::Core &core,
+                              const std::string &device,
+                              ov::CompiledModel &compiled_model,
+                              std::shared_ptr<MappedBlob> *mapped_blob) {
+  const std::string path = BlobPath(key);
+  if (use_mmap_ && mapped_blob != nullptr) {
+    *mapped_blob = MappedBlob::Open(path);
+    if (*mapped_blob == nullptr) {
+      misses_++;
+      return false;
+    }
+  } else if (!std::filesystem::exists(path)) {
+    misses_++;
+    return false;
+  }
+
+  try {
+    if (use_mmap_ && mapped_blob != nullptr) {
+      compiled_model =
+          (*mapped_blob)->Import(core, device, 0, (*mapped_blob)->size());
+    } else {
+      std::ifstream blob(path, std::ios::binary);
+      compiled_model = core.import_model(blob, device);
+    }
+  } catch (const std::exception &e) {
+    TFLITE_LOG(ERROR) << "Discarding unusable OpenVINO cache entry " << path
+                      << ": " << e.what() << "\n";
+    if (mapped_blob != nullptr) mapped_blob->reset();
+    std::error_code ec;
+    std::filesystem::remove(path, ec);
+    misses_++;
+    return false;
+  }
+
+  // Refresh the timestamp so that eviction drops the least recently used
+  // blobs first.
+  std::error_code ec;
+  std::filesystem::last_write_time(
+      path, std::filesystem::file_time_type::clock::now(), ec);
+  hits_++;
+  return true;
+}
+
+TfLiteStatus OpenVINOModelCache::Store(const std::string &key,
+                                       ov::CompiledModel &compiled_model) {
+  const std::string path = BlobPath(key);
+  // Write to a file private to this writer first so that concurrent
+  // processes, threads and delegates never observe a partially written blob
+  // nor write the same file.
+  const std::string tmp_path = path + ".tmp." + std::to_string(getpid()) +
+                               "." + std::to_string(next_writer++);
+  {
+    std::ofstream blob(tmp_path, std::ios::binary | std::ios::trunc);
+    if (!blob.is_open()) {
+      TFLITE_LOG(ERROR) << "Unable to open " << tmp_path << " for writing\n";
+      return kTfLiteError;
+    }
+    try {
+      compiled_model.export_model(blob);
+    } catch (const std::exception &e) {
+      TFLITE_LOG(ERROR) << "Unable to export compiled model: " << e.what()
+                        << "\n";
+      blob.close();
+      std::remove(tmp_path.c_str());
+      return kTfLiteError;
+    }
+  }
+
+  std::error_code ec;
+  std::filesystem::rename(tmp_path, path, ec);
+  if (ec) {
+    std::filesystem::remove(tmp_path, ec);
+    return kTfLiteError;
+  }
+
+  EvictIfNeeded();
+  return kTfLiteOk;
+}
+
+void OpenVINOModelCache::EvictIfNeeded() {
+  if (max_size_bytes_ <= 0) return;
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  struct Entry {
+    std::filesystem::path path;
+    std::filesystem::file_time_type last_used;
+    uintmax_t size;
+  };
+  std::vector<Entry> entries;
+  uintmax_t total_size = 0;
+  std::error_code ec;
+  for (const auto &file :
+       std::filesystem::directory_iterator(cache_dir_, ec)) {
+    if (!file.is_regular_file() || file.path().extension() != kBlobExtension)
+      continue;
+    Entry entry{file.path(), file.last_write_time(ec), file.file_size(ec)};
+    if (ec) continue;
+    total_size += entry.size;
+    entries.push_back(std::move(entry));
+  }
+
+  std::sort(entries.begin(), entries.end(),
+            [](const Entry &a, const Entry &b) {
+              return a.last_used < b.last_used;
+            });
+  for (const auto &entry : entries) {
+    if (total_size <= static_cast<uintmax_t>(max_size_bytes_)) break;
+    if (std::filesystem::remove(entry.path, ec)) total_size -= entry.size;
+  }
+}
+
+}  // namespace openvinodelegate
+}  // namespace tflite
@@ -0,0 +1,79 @@
+// Copyright (C) 2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef TENSORFLOW_LITE_DELEGATES_OPENVINO_MODEL_CACHE_H_
+#define TENSORFLOW_LITE_DELEGATES_OPENVINO_MODEL_CACHE_H_
+#include <atomic>
+#include <mutex>
+#include <openvino/openvino.hpp>
+#include <openvino/runtime/core.hpp>
+#include <string>
+
+#include "openvino_mapped_blob.h"
+#include "tensorflow/lite/c/c_api_opaque.h"
+#include "tensorflow/lite/c/common.h"
+
+namespace tflite {
+namespace openvinodelegate {
+
+// On-disk cache of compiled delegate partitions. Every partition is stored as
+// one exported ov::CompiledModel blob named after its partition key, so a warm
+// start imports the blob and skips both graph construction and compilation.
+class OpenVINOModelCache {
+ public:
+  // max_size_bytes bounds the total size of the cached blobs, 0 disables
+  // eviction. With use_mmap, blobs are imported from a read-only shared
+  // mapping instead of being read into private memory.
+  OpenVINOModelCache(std::string cache_dir, int64_t max_size_bytes,
+                     bool use_mmap = false);
+
+  // Version of the lowering of TFLite ops to OpenVINO graphs. Bump it
+  // whenever the graph built for a partition changes, so that blobs compiled
+  // by an older delegate are neither loaded from the cache nor imported from
+  // a precompiled container.
+  static constexpr uint32_t kDelegateCacheVersion = 1;
+
+  // Returns a key that identifies the partition described by params: the
+  // delegate cache version, the target device and compile properties, the
+  // OpenVINO runtime build, every node's op code and parameters, the shapes
+  // and types of all tensors it touches and the contents of its constant
+  // tensors.
+  static std::string ComputeKey(TfLiteOpaqueContext *context,
+                                const TfLiteOpaqueDelegateParams *params,
+                                const std::string &device,
+                                const ov::AnyMap &properties = {});
+
+  // Whether a blob is stored under key. Does not count as a hit or a miss.
+  bool Contains(const std::string &key) const;
+
+  // Imports the blob stored under key into compiled_model. Returns false on a
+  // cache miss or when the blob cannot be imported. In mmap mode, mapped_blob
+  // receives the mapping that must be kept alive with compiled_model.
+  bool Load(const std::string &key, ov::Core &core, const std::string &device,
+            ov::CompiledModel &compiled_model,
+            std::shared_ptr<MappedBlob> *mapped_blob = nullptr);
+
+  // Exports compiled_model under key and evicts the least recently used
+  // blobs if the cache grows past its size limit.
+  TfLiteStatus Store(const std::string &key, ov::CompiledModel &compiled_model);
+
+  uint64_t getHits() const { return hits_; }
+
+  uint64_t getMisses() const { return misses_; }
+
+ private:
+  std::string BlobPath(const std::string &key) const;
+  void EvictIfNeeded();
+
+  std::string cache_dir_;
+  int64_t max_size_bytes_;
+  bool use_mmap_;
+  std::atomic<uint64_t> hits_{0};
+  std::atomic<uint64_t> misses_{0};
+  std::mutex mutex_;
+};
+
+}  // namespace openvinodelegate
+}  // namespace tflite
+#endif  // TENSORFLOW_LITE_DELEGATES_OPENVINO_MODEL_CACHE_H_
@@ -0,0 +1,93 @@
+// Copyright (C) 2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#include "openvino_model_cache.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <thread>
+#include <vector>
+
+#include "openvino_test_model.h"
+
+namespace tflite {
+namespace openvinodelegate {
+
+class OpenVINOModelCacheTest : public OpenVINOCompiledModelTest {
+ protected:
+  void SetUp() override {
+    cache_dir_ = (std::filesystem::path(testing::TempDir()) /
+                  testing::UnitTest::GetInstance()->current_test_info()->name())
+                     .string();
+    std::filesystem::remove_all(cache_dir_);
+    OpenVINOCompiledModelTest::SetUp();
+  }
+
+  void TearDown() override { std::filesystem::remove_all(cache_dir_); }
+
+  std::string cache_dir_;
+};
+
+TEST_F(OpenVINOModelCacheTest, LoadMissOnEmptyCache) {
+  OpenVINOModelCache cache(cache_dir_, 0);
+  ov::CompiledModel loaded;
+  EXPECT_FALSE(cache.Load("0123456789abcdef", core_, "CPU", loaded));
+  EXPECT_EQ(cache.getHits(), 0);
+  EXPECT_EQ(cache.getMisses(), 1);
+}
+
+TEST_F(OpenVINOModelCacheTest, StoreThenLoadHits) {
+  OpenVINOModelCache cache(cache_dir_, 0);
+  EXPECT_EQ(kTfLiteOk, cache.Store("0123456789abcdef", compiled_model_));
+
+  ov::CompiledModel loaded;
+  EXPECT_TRUE(cache.Load("0123456789abcdef", core_, "CPU", loaded));
+  EXPECT_EQ(loaded.inputs().size(), 1);
+  EXPECT_EQ(cache.getHits(), 1);
+  EXPECT_EQ(cache.getMisses(), 0);
+}
+
+TEST_F(OpenVINOModelCacheTest, ConcurrentStoresOfOneKey) {
+  OpenVINOModelCache cache(cache_dir_, 0);
+  std::vector<std::thread> writers;
+  for (int i = 0; i < 4; i++) {
+    writers.emplace_back([&] {
+      EXPECT_EQ(kTfLiteOk, cache.Store("0123456789abcdef", compiled_model_));
+    });
+  }
+  for (std::thread &writer : writers) writer.join();
+
+  ov::CompiledModel loaded;
+  EXPECT_TRUE(cache.Load("0123456789abcdef", core_, "CPU", loaded));
+  EXPECT_EQ(loaded.inputs().size(), 1);
+  // Only the blob is left, no temporary file of a writer.
+  EXPECT_EQ(1, std::distance(std::filesystem::directory_iterator(cache_dir_),
+                             std::filesystem::directory_iterator()));
+}
+
+TEST_F(OpenVINOModelCacheTest, EvictsBeyondSizeLimit) {
+  OpenVINOModelCache cache(cache_dir_, 1);
+  EXPECT_EQ(kTfLiteOk, cache.Store("0123456789abcdef", compiled_model_));
+
+  ov::CompiledModel loaded;
+  EXPECT_FALSE(cache.Load("0123456789abcdef", core_, "CPU", loaded));
+  EXPECT_EQ(cache.getMisses(), 1);
+}
+
+TEST_F(OpenVINOModelCacheTest, DiscardsCorruptedBlob) {
+  OpenVINOModelCache cache(cache_dir_, 0);
+  std::ofstream(std::filesystem::path(cache_dir_) / "0123456789abcdef.blob")
+      << "not a compiled model";
+
+  ov::CompiledModel loaded;
+  EXPECT_FALSE(cache.Load("0123456789abcdef", core_, "CPU", loaded));
+  EXPECT_FALSE(std::filesystem::exists(std::filesystem::path(cache_dir_) /
+                                       "0123456789abcdef.blob"));
+}
+
+}  // namespace openvinodelegate
+}  // namespace tflite
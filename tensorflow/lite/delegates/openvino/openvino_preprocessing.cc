@@ -0,0 +1,122 @@
+// Copyright (C) 2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#include "openvino_preprocessing.h"
+
+#include <limits>
+#include <openvino/core/preprocess/pre_post_process.hpp>
+#include <sstream>
+
+namespace tflite {
+namespace openvinodelegate {
+namespace {
+
+bool ParseFloats(const std::string &value, std::vector<float> &floats) {
+  std::istringstream stream(value);
+  std::string item;
+  while (std::getline(stream, item, ',')) {
+    size_t end = 0;
+    try {
+      floats.push_back(std::stof(item, &end));
+    } catch (const std::exception &) {
+      return false;
+    }
+    if (end != item.size()) return false;
+  }
+  return !floats.empty();
+}
+
+// Parses the whole of value as a non-negative integer, rejecting trailing
+// characters that std::stoll would ignore, e.g. "3x".
+bool ParseCount(const std::string &value, size_t &count) {
+  size_t end = 0;
+  long long parsed;
+  try {
+    parsed = std::stoll(value, &end);
+  } catch (const std::exception &) {
+    return false;
+  }
+  if (end != value.size() || parsed < 0) return false;
+  count = static_cast<size_t>(parsed);
+  return true;
+}
+
+}  // namespace
+
+std::shared_ptr<OpenVINOPreprocessing> OpenVINOPreprocessing::Parse(
+    const std::string &spec) {
+  auto preprocessing = std::make_shared<OpenVINOPreprocessing>();
+  std::istringstream entries(spec);
+  std::string entry;
+  while (std::getline(entries, entry, ';')) {
+    if (entry.empty()) continue;
+    const size_t separator = entry.find('=');
+    if (separator == std::string::npos) return nullptr;
+    const std::string key = entry.substr(0, separator);
+    const std::string value = entry.substr(separator + 1);
+    try {
+      if (key == "input") {
+        size_t input;
+        if (!ParseCount(value, input) ||
+            input > static_cast<size_t>(std::numeric_limits<int>::max()))
+          return nullptr;
+        preprocessing->input_ = static_cast<int>(input);
+      } else if (key == "element_type") {
+        if (value != "u8" && value != "f32") return nullptr;
+        preprocessing->element_type_ = ov::element::Type(value);
+      } else if (key == "color_format") {
+        if (value != "RGB" && value != "BGR" && value != "NV12")
+          return nullptr;
+        preprocessing->color_format_ = value;
+      } else if (key == "mean") {
+        if (!ParseFloats(value, preprocessing->mean_)) return nullptr;
+      } else if (key == "scale") {
+        if (!ParseFloats(value, preprocessing->scale_)) return nullptr;
+      } else if (key == "resize") {
+        const size_t x = value.find('x');
+        if (x == std::string::npos) return nullptr;
+        if (!ParseCount(value.substr(0, x), preprocessing->height_) ||
+            !ParseCount(value.substr(x + 1), preprocessing->width_) ||
+            preprocessing->height_ == 0 || preprocessing->width_ == 0)
+          return nullptr;
+      } else {
+        return nullptr;
+      }
+    } catch (const std::exception &) {
+      return nullptr;
+    }
+    preprocessing->spec_ += entry + ";";
+  }
+  return preprocessing;
+}
+
+std::shared_ptr<ov::Model> OpenVINOPreprocessing::Apply(
+    const std::shared_ptr<ov::Model> &model,
+    const std::vector<size_t> &inputs) const {
+  ov::preprocess::PrePostProcessor ppp(model);
+  for (size_t index : inputs) {
+    ov::preprocess::InputInfo &input = ppp.input(index);
+    input.tensor().set_element_type(element_type_).set_layout("NHWC");
+    if (color_format_ == "NV12") {
+      input.tensor().set_color_format(
+          ov::preprocess::ColorFormat::NV12_SINGLE_PLANE);
+    } else if (color_format_ == "BGR") {
+      input.tensor().set_color_format(ov::preprocess::ColorFormat::BGR);
+    }
+    if (height_ != 0) input.tensor().set_spatial_static_shape(height_, width_);
+    input.model().set_layout("NHWC");
+
+    input.preprocess().convert_element_type(ov::element::f32);
+    if (color_format_ != "RGB")
+      input.preprocess().convert_color(ov::preprocess::ColorFormat::RGB);
+    if (height_ != 0)
+      input.preprocess().resize(ov::preprocess::ResizeAlgorithm::RESIZE_LINEAR);
+    if (!mean_.empty()) input.preprocess().mean(mean_);
+    if (!scale_.empty()) input.preprocess().scale(scale_);
+  }
+  return ppp.build();
+}
+
+}  // namespace openvinodelegate
+}  // namespace tflite
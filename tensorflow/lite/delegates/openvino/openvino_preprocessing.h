@@ -0,0 +1,56 @@
+// Copyright (C) 2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef TENSORFLOW_LITE_DELEGATES_OPENVINO_PREPROCESSING_H_
+#define TENSORFLOW_LITE_DELEGATES_OPENVINO_PREPROCESSING_H_
+#include <memory>
+#include <openvino/openvino.hpp>
+#include <string>
+#include <vector>
+
+namespace tflite {
+namespace openvinodelegate {
+
+// Image preprocessing folded into the compiled model with
+// ov::preprocess::PrePostProcessor, so that the device converts raw frames
+// instead of the application. Parsed from "KEY=VALUE;..." with the keys
+//   input         TFLite tensor index, all 4D float32 inputs if omitted
+//   element_type  of the frames, u8 (default) or f32
+//   color_format  of the frames, RGB (default), BGR or NV12, converted to
+//                 the RGB the model expects
+//   mean, scale   per channel, or one value for all, subtracted from and
+//                 then dividing the converted frame
+//   resize        HxW of the frames, resized linearly to the model input
+class OpenVINOPreprocessing {
+ public:
+  // Returns null for a malformed spec.
+  static std::shared_ptr<OpenVINOPreprocessing> Parse(const std::string &spec);
+
+  // Whether the NHWC float32 input tensor_index is fed raw frames.
+  bool AppliesTo(int tensor_index) const {
+    return input_ < 0 || input_ == tensor_index;
+  }
+
+  // Returns model with the preprocessing of its Parameters at inputs. Throws
+  // ov::Exception if the plugin-independent conversion cannot be built.
+  std::shared_ptr<ov::Model> Apply(const std::shared_ptr<ov::Model> &model,
+                                   const std::vector<size_t> &inputs) const;
+
+  // Normalized spec, part of the partition key of preprocessed models.
+  const std::string &getSpec() const { return spec_; }
+
+ private:
+  std::string spec_;
+  int input_ = -1;
+  ov::element::Type element_type_ = ov::element::u8;
+  std::string color_format_ = "RGB";
+  std::vector<float> mean_;
+  std::vector<float> scale_;
+  size_t height_ = 0;
+  size_t width_ = 0;
+};
+
+}  // namespace openvinodelegate
+}  // namespace tflite
+#endif  // TENSORFLOW_LITE_DELEGATES_OPENVINO_PREPROCESSING_H_
@@ -0,0 +1,84 @@
+// Copyright (C) 2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#include "openvino_preprocessing.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <openvino/opsets/opset8.hpp>
+
+namespace tflite {
+namespace openvinodelegate {
+namespace {
+
+std::shared_ptr<ov::Model> CreateModel() {
+  auto image = std::make_shared<ov::opset8::Parameter>(
+      ov::element::f32, ov::Shape{1, 224, 224, 3});
+  auto other = std::make_shared<ov::opset8::Parameter>(ov::element::f32,
+                                                       ov::Shape{1, 3});
+  auto relu = std::make_shared<ov::opset8::Relu>(image);
+  auto result = std::make_shared<ov::opset8::Result>(relu);
+  auto passthrough = std::make_shared<ov::opset8::Result>(other);
+  return std::make_shared<ov::Model>(ov::ResultVector{result, passthrough},
+                                     ov::ParameterVector{image, other});
+}
+
+}  // namespace
+
+TEST(OpenVINOPreprocessingTest, ParsesSpec) {
+  auto preprocessing = OpenVINOPreprocessing::Parse(
+      "input=3;color_format=BGR;mean=1,2,3;scale=255;resize=480x640");
+  ASSERT_NE(nullptr, preprocessing);
+  EXPECT_TRUE(preprocessing->AppliesTo(3));
+  EXPECT_FALSE(preprocessing->AppliesTo(4));
+  EXPECT_EQ("input=3;color_format=BGR;mean=1,2,3;scale=255;resize=480x640;",
+            preprocessing->getSpec());
+}
+
+TEST(OpenVINOPreprocessingTest, AppliesToEveryInputByDefault) {
+  auto preprocessing = OpenVINOPreprocessing::Parse("element_type=u8");
+  ASSERT_NE(nullptr, preprocessing);
+  EXPECT_TRUE(preprocessing->AppliesTo(0));
+  EXPECT_TRUE(preprocessing->AppliesTo(7));
+}
+
+TEST(OpenVINOPreprocessingTest, RejectsMalformedSpec) {
+  EXPECT_EQ(nullptr, OpenVINOPreprocessing::Parse("element_type=i64"));
+  EXPECT_EQ(nullptr, OpenVINOPreprocessing::Parse("color_format=YUV"));
+  EXPECT_EQ(nullptr, OpenVINOPreprocessing::Parse("mean=1,x"));
+  EXPECT_EQ(nullptr, OpenVINOPreprocessing::Parse("resize=480"));
+  EXPECT_EQ(nullptr, OpenVINOPreprocessing::Parse("resize=0x640"));
+  EXPECT_EQ(nullptr, OpenVINOPreprocessing::Parse("flip=1"));
+  EXPECT_EQ(nullptr, OpenVINOPreprocessing::Parse("scale"));
+  EXPECT_EQ(nullptr, OpenVINOPreprocessing::Parse("input=3x"));
+  EXPECT_EQ(nullptr, OpenVINOPreprocessing::Parse("input=-1"));
+  EXPECT_EQ(nullptr, OpenVINOPreprocessing::Parse("resize=480x640x3"));
+  EXPECT_EQ(nullptr, OpenVINOPreprocessing::Parse("resize=-480x640"));
+}
+
+TEST(OpenVINOPreprocessingTest, FoldsConversionIntoModel) {
+  auto preprocessing = OpenVINOPreprocessing::Parse(
+      "color_format=BGR;mean=127.5;scale=127.5;resize=480x640");
+  ASSERT_NE(nullptr, preprocessing);
+  std::shared_ptr<ov::Model> model = preprocessing->Apply(CreateModel(), {0});
+  EXPECT_EQ(ov::element::u8, model->input(0).get_element_type());
+  EXPECT_EQ(ov::PartialShape({1, 480, 640, 3}),
+            model->input(0).get_partial_shape());
+  // Inputs not listed are left untouched.
+  EXPECT_EQ(ov::element::f32, model->input(1).get_element_type());
+  EXPECT_EQ(ov::PartialShape({1, 224, 224, 3}),
+            model->output(0).get_partial_shape());
+}
+
+TEST(OpenVINOPreprocessingTest, AcceptsSinglePlaneNV12) {
+  auto preprocessing = OpenVINOPreprocessing::Parse("color_format=NV12");
+  ASSERT_NE(nullptr, preprocessing);
+  std::shared_ptr<ov::Model> model = preprocessing->Apply(CreateModel(), {0});
+  EXPECT_EQ(ov::PartialShape({1, 336, 224, 1}),
+            model->input(0).get_partial_shape());
+}
+
+}  // namespace openvinodelegate
+}  // namespace tflite
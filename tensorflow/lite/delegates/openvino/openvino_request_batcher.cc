@@ -0,0 +1,74 @@
+// Copyright (C) 2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#include "openvino_request_batcher.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace tflite {
+namespace openvinodelegate {
+
+OpenVINORequestBatcher::OpenVINORequestBatcher(
+    size_t max_batch, std::chrono::microseconds max_wait, Run run)
+    : max_batch_(std::max<size_t>(1, max_batch)),
+      max_wait_(max_wait),
+      run_(std::move(run)) {
+  pending_.reserve(max_batch_);
+  running_batch_.reserve(max_batch_);
+}
+
+TfLiteStatus OpenVINORequestBatcher::Submit(Request &request) {
+  using Clock = std::chrono::steady_clock;
+  request.arrived = Clock::now();
+  std::unique_lock<std::mutex> lock(mutex_);
+  // The next batch is full, wait for it to start.
+  changed_.wait(lock, [this] { return pending_.size() < max_batch_; });
+  request.done = false;
+  const bool leader = pending_.empty();
+  pending_.push_back(&request);
+
+  if (!leader) {
+    if (pending_.size() == max_batch_) changed_.notify_all();
+    changed_.wait(lock, [&request] { return request.done; });
+    return request.status;
+  }
+
+  if (submitters_ > 1) {
+    const Clock::time_point deadline = request.arrived + max_wait_;
+    changed_.wait_until(
+        lock, deadline, [this] { return pending_.size() == max_batch_; });
+  }
+  changed_.wait(lock, [this] { return !running_; });
+  std::swap(pending_, running_batch_);
+  running_ = true;
+  const Clock::time_point started = Clock::now();
+  lock.unlock();
+  // Callers waiting for room in pending_ can form the next batch.
+  changed_.notify_all();
+
+  const TfLiteStatus status =
+      run_(running_batch_.data(), running_batch_.size());
+  const Clock::time_point completed = Clock::now();
+
+  lock.lock();
+  stats_.batches++;
+  stats_.requests += running_batch_.size();
+  for (Request *batched : running_batch_) {
+    stats_.total_wait += std::chrono::duration_cast<std::chrono::microseconds>(
+        started - batched->arrived);
+    stats_.total_latency +=
+        std::chrono::duration_cast<std::chrono::microseconds>(
+            completed - batched->arrived);
+    batched->status = status;
+    batched->done = true;
+  }
+  running_batch_.clear();
+  running_ = false;
+  changed_.notify_all();
+  return status;
+}
+
+}  // namespace openvinodelegate
+}  // namespace tflite
@@ -0,0 +1,93 @@
+// Copyright (C) 2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef TENSORFLOW_LITE_DELEGATES_OPENVINO_REQUEST_BATCHER_H_
+#define TENSORFLOW_LITE_DELEGATES_OPENVINO_REQUEST_BATCHER_H_
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+#include "tensorflow/lite/c/common.h"
+
+namespace tflite {
+namespace openvinodelegate {
+
+// Stacks the invocations of a partition made concurrently by several
+// interpreters into one inference of a model compiled for max_batch rows.
+// The first caller to arrive leads the batch: it waits up to max_wait for
+// others to join, unless it is the only submitter, runs the batch on its own
+// thread, and wakes the callers once their outputs were scattered back.
+// Batches run one at a time, callers arriving meanwhile form the next one.
+class OpenVINORequestBatcher {
+ public:
+  // One invocation, its buffers hold one row of the batch each.
+  struct Request {
+    const void *const *inputs = nullptr;
+    void *const *outputs = nullptr;
+    TfLiteStatus status = kTfLiteOk;
+    bool done = false;
+    std::chrono::steady_clock::time_point arrived;
+  };
+
+  // Runs count requests as one batch, count is at most max_batch.
+  using Run = std::function<TfLiteStatus(Request *const *requests,
+                                         size_t count)>;
+
+  OpenVINORequestBatcher(size_t max_batch, std::chrono::microseconds max_wait,
+                         Run run);
+
+  // Blocks until request ran as part of a batch and returns its status. Does
+  // not allocate.
+  TfLiteStatus Submit(Request &request);
+
+  // Kernels submitting to the batcher, each from its own interpreter. A
+  // caller with no other submitter to wait for runs at once, so that
+  // batching adds no latency to a lone interpreter.
+  void AddSubmitter() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    submitters_++;
+  }
+  void RemoveSubmitter() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    submitters_--;
+  }
+
+  size_t getMaxBatch() const { return max_batch_; }
+
+  // Counters: batches run, requests they held, so that
+  // requests / (batches * max_batch) is the occupancy of the batches, and
+  // the total time requests waited for their batch to start and to
+  // complete.
+  struct Stats {
+    uint64_t batches = 0;
+    uint64_t requests = 0;
+    std::chrono::microseconds total_wait{0};
+    std::chrono::microseconds total_latency{0};
+  };
+
+  Stats getStats() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+  }
+
+ private:
+  size_t max_batch_;
+  std::chrono::microseconds max_wait_;
+  Run run_;
+  std::mutex mutex_;
+  std::condition_variable changed_;
+  // Requests of the next batch, and of the batch running if running_.
+  std::vector<Request *> pending_;
+  std::vector<Request *> running_batch_;
+  bool running_ = false;
+  size_t submitters_ = 0;
+  Stats stats_;
+};
+
+}  // namespace openvinodelegate
+}  // namespace tflite
+#endif  // TENSORFLOW_LITE_DELEGATES_OPENVINO_REQUEST_BATCHER_H_
@@ -0,0 +1,141 @@
+// Copyright (C) 2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#include "openvino_request_batcher.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace tflite {
+namespace openvinodelegate {
+
+// Doubles the single float input of each request into its output.
+TfLiteStatus DoubleRows(OpenVINORequestBatcher::Request *const *requests,
+                        size_t count) {
+  for (size_t k = 0; k < count; k++) {
+    *static_cast<float *>(requests[k]->outputs[0]) =
+        2 * *static_cast<const float *>(requests[k]->inputs[0]);
+  }
+  return kTfLiteOk;
+}
+
+TEST(OpenVINORequestBatcherTest, RunsLoneSubmitterAtOnce) {
+  OpenVINORequestBatcher batcher(4, std::chrono::seconds(10), DoubleRows);
+  batcher.AddSubmitter();
+  float input = 3, output = 0;
+  const void *inputs[] = {&input};
+  void *outputs[] = {&output};
+  OpenVINORequestBatcher::Request request;
+  request.inputs = inputs;
+  request.outputs = outputs;
+  EXPECT_EQ(kTfLiteOk, batcher.Submit(request));
+  EXPECT_EQ(6, output);
+  OpenVINORequestBatcher::Stats stats = batcher.getStats();
+  EXPECT_EQ(1, stats.batches);
+  EXPECT_EQ(1, stats.requests);
+  EXPECT_LT(stats.total_wait.count(), 1000000);
+}
+
+TEST(OpenVINORequestBatcherTest, RunsLoneRequestAfterMaxWait) {
+  OpenVINORequestBatcher batcher(4, std::chrono::microseconds(1000),
+                                 DoubleRows);
+  // The other submitter does not invoke, the request waits for it in vain.
+  batcher.AddSubmitter();
+  batcher.AddSubmitter();
+  float input = 3, output = 0;
+  const void *inputs[] = {&input};
+  void *outputs[] = {&output};
+  OpenVINORequestBatcher::Request request;
+  request.inputs = inputs;
+  request.outputs = outputs;
+  EXPECT_EQ(kTfLiteOk, batcher.Submit(request));
+  EXPECT_EQ(6, output);
+  OpenVINORequestBatcher::Stats stats = batcher.getStats();
+  EXPECT_EQ(1, stats.batches);
+  EXPECT_EQ(1, stats.requests);
+  EXPECT_GE(stats.total_wait.count(), 1000);
+}
+
+TEST(OpenVINORequestBatcherTest, StacksConcurrentRequests) {
+  constexpr int kCallers = 8;
+  std::atomic<size_t> largest_batch{0};
+  OpenVINORequestBatcher batcher(
+      kCallers, std::chrono::seconds(10),
+      [&](OpenVINORequestBatcher::Request *const *requests, size_t count) {
+        largest_batch = std::max<size_t>(largest_batch, count);
+        return DoubleRows(requests, count);
+      });
+  for (int c = 0; c < kCallers; c++) batcher.AddSubmitter();
+  std::vector<float> inputs(kCallers), outputs(kCallers);
+  std::vector<std::thread> callers;
+  for (int c = 0; c < kCallers; c++) {
+    inputs[c] = c;
+    callers.emplace_back([&, c] {
+      const void *input[] = {&inputs[c]};
+      void *output[] = {&outputs[c]};
+      OpenVINORequestBatcher::Request request;
+      request.inputs = input;
+      request.outputs = output;
+      EXPECT_EQ(kTfLiteOk, batcher.Submit(request));
+    });
+  }
+  for (std::thread &caller : callers) caller.join();
+  // A full batch does not wait for max_wait.
+  EXPECT_EQ(kCallers, largest_batch);
+  EXPECT_EQ(1, batcher.getStats().batches);
+  for (int c = 0; c < kCallers; c++) EXPECT_EQ(2 * c, outputs[c]);
+}
+
+TEST(OpenVINORequestBatcherTest, ReportsBatchFailureToEveryCaller) {
+  OpenVINORequestBatcher batcher(
+      2, std::chrono::seconds(10),
+      [](OpenVINORequestBatcher::Request *const *, size_t) {
+        return kTfLiteError;
+      });
+  batcher.AddSubmitter();
+  batcher.AddSubmitter();
+  std::vector<std::thread> callers;
+  std::atomic<int> failed{0};
+  for (int c = 0; c < 2; c++) {
+    callers.emplace_back([&] {
+      OpenVINORequestBatcher::Request request;
+      if (batcher.Submit(request) == kTfLiteError) failed++;
+    });
+  }
+  for (std::thread &caller : callers) caller.join();
+  EXPECT_EQ(2, failed);
+}
+
+TEST(OpenVINORequestBatcherTest, SplitsMoreCallersThanMaxBatch) {
+  constexpr int kCallers = 12;
+  OpenVINORequestBatcher batcher(4, std::chrono::microseconds(200),
+                                 DoubleRows);
+  for (int c = 0; c < kCallers; c++) batcher.AddSubmitter();
+  std::vector<float> inputs(kCallers), outputs(kCallers);
+  std::vector<std::thread> callers;
+  for (int c = 0; c < kCallers; c++) {
+    inputs[c] = c;
+    callers.emplace_back([&, c] {
+      const void *input[] = {&inputs[c]};
+      void *output[] = {&outputs[c]};
+      OpenVINORequestBatcher::Request request;
+      request.inputs = input;
+      request.outputs = output;
+      EXPECT_EQ(kTfLiteOk, batcher.Submit(request));
+    });
+  }
+  for (std::thread &caller : callers) caller.join();
+  OpenVINORequestBatcher::Stats stats = batcher.getStats();
+  EXPECT_EQ(kCallers, stats.requests);
+  EXPECT_GE(stats.batches, kCallers / 4);
+  for (int c = 0; c < kCallers; c++) EXPECT_EQ(2 * c, outputs[c]);
+}
+
+}  // namespace openvinodelegate
+}  // namespace tflite
@@ -0,0 +1,80 @@
+// Copyright (C) 2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#include "openvino_shape_buckets.h"
+
+#include <algorithm>
+#include <cstring>
+#include <sstream>
+
+namespace tflite {
+namespace openvinodelegate {
+
+std::shared_ptr<OpenVINOShapeBuckets> OpenVINOShapeBuckets::Parse(
+    const std::string &lengths, int axis) {
+  if (axis < 0) return nullptr;
+  std::vector<int64_t> parsed;
+  std::istringstream stream(lengths);
+  std::string length;
+  while (std::getline(stream, length, ',')) {
+    size_t end = 0;
+    int64_t value = 0;
+    try {
+      value = std::stoll(length, &end);
+    } catch (const std::exception &) {
+      return nullptr;
+    }
+    if (value <= 0 || length.find_first_not_of(' ', end) != std::string::npos)
+      return nullptr;
+    parsed.push_back(value);
+  }
+  if (parsed.empty()) return nullptr;
+  std::sort(parsed.begin(), parsed.end());
+  parsed.erase(std::unique(parsed.begin(), parsed.end()), parsed.end());
+  return std::make_shared<OpenVINOShapeBuckets>(std::move(parsed), axis);
+}
+
+OpenVINOShapeBuckets::OpenVINOShapeBuckets(std::vector<int64_t> lengths,
+                                           int axis)
+    : lengths_(std::move(lengths)),
+      axis_(axis),
+      hits_(new std::atomic<uint64_t>[lengths_.size()]) {
+  for (size_t bucket = 0; bucket < lengths_.size(); bucket++)
+    hits_[bucket] = 0;
+}
+
+int OpenVINOShapeBuckets::Select(int64_t length) {
+  auto bucket = std::lower_bound(lengths_.begin(), lengths_.end(), length);
+  if (bucket == lengths_.end()) return -1;
+  const int index = bucket - lengths_.begin();
+  hits_[index]++;
+  return index;
+}
+
+void OpenVINOShapeBuckets::Pad(const void *src, void *dst, size_t outer,
+                               size_t src_length, size_t dst_length,
+                               size_t item_bytes) {
+  const size_t src_row = src_length * item_bytes;
+  const size_t dst_row = dst_length * item_bytes;
+  for (size_t row = 0; row < outer; row++) {
+    uint8_t *out = static_cast<uint8_t *>(dst) + row * dst_row;
+    std::memcpy(out, static_cast<const uint8_t *>(src) + row * src_row,
+                src_row);
+    std::memset(out + src_row, 0, dst_row - src_row);
+  }
+}
+
+void OpenVINOShapeBuckets::Crop(const void *src, void *dst, size_t outer,
+                                size_t src_length, size_t dst_length,
+                                size_t item_bytes) {
+  const size_t src_row = src_length * item_bytes;
+  const size_t dst_row = dst_length * item_bytes;
+  for (size_t row = 0; row < outer; row++) {
+    std::memcpy(static_cast<uint8_t *>(dst) + row * dst_row,
+                static_cast<const uint8_t *>(src) + row * src_row, dst_row);
+  }
+}
+
+}  // namespace openvinodelegate
+}  // namespace tflite
@@ -0,0 +1,58 @@
+// Copyright (C) 2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef TENSORFLOW_LITE_DELEGATES_OPENVINO_SHAPE_BUCKETS_H_
+#define TENSORFLOW_LITE_DELEGATES_OPENVINO_SHAPE_BUCKETS_H_
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace tflite {
+namespace openvinodelegate {
+
+// Lengths a variable axis of the partition inputs is padded to, so that each
+// partition is compiled once per bucket with static shapes instead of once
+// with dynamic ones. Shared by the kernels of a delegate, which count the
+// invocations served by each bucket.
+class OpenVINOShapeBuckets {
+ public:
+  // Parses a comma separated list of positive lengths, e.g. "32,64,128".
+  // Returns null for an empty or malformed list.
+  static std::shared_ptr<OpenVINOShapeBuckets> Parse(const std::string &lengths,
+                                                     int axis);
+
+  // lengths must be positive and sorted in ascending order.
+  OpenVINOShapeBuckets(std::vector<int64_t> lengths, int axis);
+
+  // Index of the smallest bucket that holds length, counted as a hit of
+  // that bucket, or -1 if length exceeds the largest one.
+  int Select(int64_t length);
+
+  // Copies outer rows of src_length items of item_bytes bytes each into
+  // rows of dst_length items, zeroing the items past src_length.
+  static void Pad(const void *src, void *dst, size_t outer, size_t src_length,
+                  size_t dst_length, size_t item_bytes);
+
+  // Reverse of Pad, copies the first dst_length items of each row.
+  static void Crop(const void *src, void *dst, size_t outer,
+                   size_t src_length, size_t dst_length, size_t item_bytes);
+
+  int getAxis() const { return axis_; }
+  size_t getCount() const { return lengths_.size(); }
+  int64_t getLength(size_t bucket) const { return lengths_[bucket]; }
+  int64_t getMaxLength() const { return lengths_.back(); }
+  uint64_t getHits(size_t bucket) const { return hits_[bucket]; }
+
+ private:
+  std::vector<int64_t> lengths_;
+  int axis_;
+  std::unique_ptr<std::atomic<uint64_t>[]> hits_;
+};
+
+}  // namespace openvinodelegate
+}  // namespace tflite
+#endif  // TENSORFLOW_LITE_DELEGATES_OPENVINO_SHAPE_BUCKETS_H_
@@ -0,0 +1,60 @@
+// Copyright (C) 2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#include "openvino_shape_buckets.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <vector>
+
+namespace tflite {
+namespace openvinodelegate {
+
+TEST(OpenVINOShapeBucketsTest, ParsesSortedLengths) {
+  auto buckets = OpenVINOShapeBuckets::Parse("128, 32,64,32", 1);
+  ASSERT_NE(buckets, nullptr);
+  ASSERT_EQ(3, buckets->getCount());
+  EXPECT_EQ(32, buckets->getLength(0));
+  EXPECT_EQ(64, buckets->getLength(1));
+  EXPECT_EQ(128, buckets->getMaxLength());
+  EXPECT_EQ(1, buckets->getAxis());
+}
+
+TEST(OpenVINOShapeBucketsTest, RejectsMalformedLengths) {
+  EXPECT_EQ(nullptr, OpenVINOShapeBuckets::Parse("", 1));
+  EXPECT_EQ(nullptr, OpenVINOShapeBuckets::Parse("32,x", 1));
+  EXPECT_EQ(nullptr, OpenVINOShapeBuckets::Parse("32,0", 1));
+  EXPECT_EQ(nullptr, OpenVINOShapeBuckets::Parse("32,64k", 1));
+  EXPECT_EQ(nullptr, OpenVINOShapeBuckets::Parse("32", -1));
+}
+
+TEST(OpenVINOShapeBucketsTest, SelectsSmallestFittingBucket) {
+  OpenVINOShapeBuckets buckets({32, 64, 128}, 1);
+  EXPECT_EQ(0, buckets.Select(1));
+  EXPECT_EQ(0, buckets.Select(32));
+  EXPECT_EQ(1, buckets.Select(33));
+  EXPECT_EQ(2, buckets.Select(128));
+  EXPECT_EQ(-1, buckets.Select(129));
+  EXPECT_EQ(2, buckets.getHits(0));
+  EXPECT_EQ(1, buckets.getHits(1));
+  EXPECT_EQ(1, buckets.getHits(2));
+}
+
+TEST(OpenVINOShapeBucketsTest, PadsAndCropsRows) {
+  // Two rows of three items, padded to rows of five.
+  const std::vector<float> src = {1, 2, 3, 4, 5, 6};
+  std::vector<float> padded(10, -1);
+  OpenVINOShapeBuckets::Pad(src.data(), padded.data(), 2, 3, 5,
+                            sizeof(float));
+  EXPECT_THAT(padded, testing::ElementsAre(1, 2, 3, 0, 0, 4, 5, 6, 0, 0));
+
+  std::vector<float> cropped(6);
+  OpenVINOShapeBuckets::Crop(padded.data(), cropped.data(), 2, 5, 3,
+                             sizeof(float));
+  EXPECT_EQ(src, cropped);
+}
+
+}  // namespace openvinodelegate
+}  // namespace tflite
@@ -0,0 +1,35 @@
+// Copyright (C) 2024 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#ifndef TENSORFLOW_LITE_DELEGATES_OPENVINO_TEST_MODEL_H_
+#define TENSORFLOW_LITE_DELEGATES_OPENVINO_TEST_MODEL_H_
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <openvino/opsets/opset8.hpp>
+#include <openvino/runtime/core.hpp>
+
+namespace tflite {
+namespace openvinodelegate {
+
+// Fixture of the tests that need some compiled model: a float {1, 4} input
+// added to itself, compiled for CPU.
+class OpenVINOCompiledModelTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    auto input = std::make_shared<ov::opset8::Parameter>(ov::element::f32,
+                                                         ov::Shape{1, 4});
+    auto add = std::make_shared<ov::opset8::Add>(input, input);
+    auto model = std::make_shared<ov::Model>(ov::OutputVector{add},
+                                             ov::ParameterVector{input});
+    compiled_model_ = core_.compile_model(model, "CPU");
+  }
+
+  ov::Core core_;
+  ov::CompiledModel compiled_model_;
+};
+
+}  // namespace openvinodelegate
+}  // namespace tflite
+#endif  // TENSORFLOW_LITE_DELEGATES_OPENVINO_TEST_MODEL_H_
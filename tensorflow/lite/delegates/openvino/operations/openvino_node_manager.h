@@ -5,7 +5,10 @@
 #ifndef TENSORFLOW_LITE_DELEGATES_OPENVINO_NODE_MANAGER_H_
 #define TENSORFLOW_LITE_DELEGATES_OPENVINO_NODE_MANAGER_H_
 
+#include <map>
 #include <openvino/openvino.hpp>
+#include <string>
+#include <unordered_set>
 
 class NodeManager {
  public:
@@ -19,13 +22,37 @@ class NodeManager {
         std::pair<int, ov::Output<ov::Node>>(index, output));
   }
 
+  bool hasOutputAtOperandIndex(int index) const {
+    return output_at_op_index_.count(index) != 0;
+  }
+
   size_t getNodeCount() const { return output_at_op_index_.size(); }
 
   bool isIndexAParam(int index) { return index_parameters_.contains(index); }
   void insertIndexParameters(int index) { index_parameters_.insert(index); }
 
+  // Whether OperationsBase::FoldConstant folds, false when constants share
+  // the memory of the TFLite tensors, which folding would copy.
+  bool getFoldConstants() const { return fold_constants_; }
+  void setFoldConstants(bool fold_constants) {
+    fold_constants_ = fold_constants;
+  }
+
+  // Constants folded by OperationsBase::FoldConstant, so that the consumers
+  // of one Constant share its folded copy.
+  std::shared_ptr<ov::Node> getFoldedConstant(const std::string &key) {
+    auto folded = folded_constants_.find(key);
+    return folded != folded_constants_.end() ? folded->second : nullptr;
+  }
+  void setFoldedConstant(const std::string &key,
+                         std::shared_ptr<ov::Node> folded) {
+    folded_constants_[key] = std::move(folded);
+  }
+
  private:
   std::map<int, ov::Output<ov::Node>> output_at_op_index_;
   std::unordered_set<int> index_parameters_;
+  bool fold_constants_ = true;
+  std::map<std::string, std::shared_ptr<ov::Node>> folded_constants_;
 };
 #endif  // TENSORFLOW_LITE_DELEGATES_OPENVINO_NODE_MANAGER_H_
@@ -8,6 +8,7 @@
 #include <openvino/openvino.hpp>
 #include <openvino/opsets/opset3.hpp>
 #include <openvino/opsets/opset8.hpp>
+#include <sstream>
 
 #include "delegate/intel_openvino/operations/openvino_node_manager.h"
 #include "tensorflow/lite/builtin_ops.h"
@@ -68,6 +69,44 @@ class OperationsBase {
     return std::make_shared<ov::opset8::Constant>(elementType, shape, data);
   }
 
+  // Returns the Constant node evaluates to when all of its inputs are
+  // constants, e.g. the Transpose of constant weights, so that the plugin
+  // gets the permuted weights instead of a subgraph to fold on every compile.
+  // Nodes of the same type and output over the same weights fold once. Does
+  // not fold when the node manager keeps constants shared with TFLite.
+  std::shared_ptr<ov::Node> FoldConstant(
+      const std::shared_ptr<ov::Node> &node) {
+    if (!node_manager_->getFoldConstants()) return node;
+    std::ostringstream key;
+    key << node->get_type_info().name << ' '
+        << node->get_output_element_type(0) << node->get_output_shape(0);
+    for (const ov::Output<ov::Node> &input : node->input_values()) {
+      auto constant = ov::as_type_ptr<ov::opset8::Constant>(
+          input.get_node_shared_ptr());
+      if (constant == nullptr) return node;
+      // Weights are told apart by their node, the graph builder already
+      // deduplicated them, and small index constants by their values.
+      const ov::element::Type type = constant->get_element_type();
+      if ((type == ov::element::i32 || type == ov::element::i64) &&
+          ov::shape_size(constant->get_shape()) <= 8) {
+        key << " [";
+        for (int64_t value : constant->cast_vector<int64_t>())
+          key << value << ',';
+        key << ']';
+      } else {
+        key << ' ' << constant.get();
+      }
+    }
+    std::shared_ptr<ov::Node> folded =
+        node_manager_->getFoldedConstant(key.str());
+    if (folded != nullptr) return folded;
+    ov::OutputVector outputs(node->get_output_size());
+    if (!node->constant_fold(outputs, node->input_values())) return node;
+    folded = outputs[0].get_node_shared_ptr();
+    node_manager_->setFoldedConstant(key.str(), folded);
+    return folded;
+  }
+
   TfLiteStatus CalculatePadding(TfLitePadding padding,
                                 ov::op::PadType &auto_pad) {
     switch (padding) {
@@ -37,8 +37,8 @@ TfLiteStatus Conv2D::CreateNode() {
     ov::AxisVector order = {0, 3, 1, 2};
     const auto order_node = ov::opset3::Constant::create(
         ov::element::i64, ov::Shape{order.size()}, order);
-    filter_node =
-        std::make_shared<ov::opset3::Transpose>(filter_node, order_node);
+    filter_node = FoldConstant(
+        std::make_shared<ov::opset3::Transpose>(filter_node, order_node));
   }
 
   auto conv_node = std::make_shared<ov::opset8::Convolution>(
@@ -46,13 +46,14 @@ TfLiteStatus Conv2D::CreateNode() {
       ov::CoordinateDiff(padding_begin), ov::CoordinateDiff(padding_end),
       ov::Strides(dilations), auto_pad);
   auto bias_dims = GetDims(tensor_indices_[BIAS_NODE]);
-  std::vector<uint32_t> shape(conv_node->get_shape().size(), 1);
+  std::vector<uint32_t> shape(
+      conv_node->get_output_partial_shape(0).rank().get_length(), 1);
   shape[1] = bias_dims[0];
   auto shape_node =
       CreateConstNode(ov::element::i32, ov::Shape{shape.size()}, shape);
 
-  bias_node =
-      std::make_shared<ov::opset3::Reshape>(bias_node, shape_node, true);
+  bias_node = FoldConstant(
+      std::make_shared<ov::opset3::Reshape>(bias_node, shape_node, true));
 
   output_node = std::make_shared<ov::opset3::Add>(
       conv_node, bias_node, ov::op::AutoBroadcastType::NUMPY);
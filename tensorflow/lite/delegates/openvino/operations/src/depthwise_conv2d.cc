@@ -43,8 +43,8 @@ TfLiteStatus DepthwiseConv2D::CreateNode() {
   //  ov::AxisVector order = {1,0,2,3};
   const auto order_node = std::make_shared<ov::opset8::Constant>(
       ov::element::i64, ov::Shape{order.size()}, order);
-  filter_node =
-      std::make_shared<ov::opset3::Transpose>(filter_node, order_node);
+  filter_node = FoldConstant(
+      std::make_shared<ov::opset3::Transpose>(filter_node, order_node));
 
   std::vector<size_t> shape(&filter_node->get_shape()[0],
                             &filter_node->get_shape()[0] + 4);
@@ -54,8 +54,8 @@ TfLiteStatus DepthwiseConv2D::CreateNode() {
   auto shape_node =
       CreateConstNode(ov::element::i32, ov::Shape{shape.size()}, shape);
 
-  filter_node =
-      std::make_shared<ov::opset3::Reshape>(filter_node, shape_node, true);
+  filter_node = FoldConstant(
+      std::make_shared<ov::opset3::Reshape>(filter_node, shape_node, true));
 
   auto depthwise_conv_node = std::make_shared<ov::opset3::GroupConvolution>(
       input_node, filter_node, ov::Strides(strides), ov::CoordinateDiff(0, 0),
@@ -63,12 +63,14 @@ TfLiteStatus DepthwiseConv2D::CreateNode() {
 
   if (has_bias) {
     auto bias_dimensions = GetDims(tensor_indices_[BIAS_NODE]);
-    std::vector<uint32_t> shape(depthwise_conv_node->get_shape().size(), 1);
+    std::vector<uint32_t> shape(
+        depthwise_conv_node->get_output_partial_shape(0).rank().get_length(),
+        1);
     shape[1] = bias_dimensions[0];
     auto shape_node =
         CreateConstNode(ov::element::i32, ov::Shape{shape.size()}, shape);
-    bias_node =
-        std::make_shared<ov::opset3::Reshape>(bias_node, shape_node, true);
+    bias_node = FoldConstant(
+        std::make_shared<ov::opset3::Reshape>(bias_node, shape_node, true));
     output_node = std::make_shared<ov::opset3::Add>(
         depthwise_conv_node, bias_node, ov::op::AutoBroadcastType::NUMPY);
   } else {
@@ -4,6 +4,8 @@
 
 #include "delegate/intel_openvino/operations/include/dequantize.h"
 
+#include <openvino/pass/constant_folding.hpp>
+
 namespace tflite {
 namespace openvinodelegate {
 
@@ -16,6 +18,9 @@ TfLiteStatus Dequantize::CreateNode() {
 
   output_node =
       std::make_shared<ov::opset8::Convert>(inputNode, ov::element::f32);
+  // Compressed weights stay compressed, the plugin decompresses them itself.
+  if (ov::is_type<ov::opset8::Constant>(inputNode))
+    ov::pass::disable_constant_folding(output_node);
 
   return kTfLiteOk;
 }
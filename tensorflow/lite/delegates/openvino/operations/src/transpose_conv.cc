@@ -53,8 +53,8 @@ TfLiteStatus TransposeConv::CreateNode() {
   ov::AxisVector order = {3, 0, 1, 2};
   const auto order_node = ov::opset3::Constant::create(
       ov::element::i64, ov::Shape{order.size()}, order);
-  weights_node =
-      std::make_shared<ov::opset3::Transpose>(weights_node, order_node);
+  weights_node = FoldConstant(
+      std::make_shared<ov::opset3::Transpose>(weights_node, order_node));
 
   std::shared_ptr<ov::Node> transpose_conv_node = nullptr;
   size_t spatial_dimensions_size = 2;
@@ -84,12 +84,14 @@ TfLiteStatus TransposeConv::CreateNode() {
     } else {
       bias_dims = GetDims(tensor_indices_[2]);
     }
-    std::vector<uint32_t> shape(transpose_conv_node->get_shape().size(), 1);
+    std::vector<uint32_t> shape(
+        transpose_conv_node->get_output_partial_shape(0).rank().get_length(),
+        1);
     shape[1] = bias_dims[0];
     auto shape_node =
         CreateConstNode(ov::element::i32, ov::Shape{shape.size()}, shape);
-    bias_node =
-        std::make_shared<ov::opset3::Reshape>(bias_node, shape_node, true);
+    bias_node = FoldConstant(
+        std::make_shared<ov::opset3::Reshape>(bias_node, shape_node, true));
     output_node = std::make_shared<ov::opset3::Add>(
         transpose_conv_node, bias_node, ov::op::AutoBroadcastType::NUMPY);
   } else {